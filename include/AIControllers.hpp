@@ -0,0 +1,103 @@
+#pragma once
+#include "AlphaBetaSearch.hpp"
+#include "DistanceField.hpp"
+#include "IController.hpp"
+#include "MonteCarloSearch.hpp"
+#include "PolicyNetwork.hpp"
+#include "WeightedAI.hpp"
+
+// IController adapters over the AIs
+
+class GreedyController : public IController
+{
+    public:
+        const char* Name() const override { return "GREEDY"; }
+        
+    protected:
+        Cell Choose(const GameState& state, int player, Clock::time_point deadline) override;
+};
+
+class PathController : public IController
+{
+    public:
+        const char* Name() const override { return "PATH"; }
+        
+    protected:
+        Cell Choose(const GameState& state, int player, Clock::time_point deadline) override;
+        
+    private:
+        DistanceField distanceField;
+};
+
+class CycleController : public IController
+{
+    public:
+        const char* Name() const override { return "CYCLE"; }
+        
+    protected:
+        Cell Choose(const GameState& state, int player, Clock::time_point deadline) override;
+};
+
+// Plays book moves in known 0-0 openings (OpeningBook::active), otherwise
+// searches until the deadline. A book hit returns at once with the move
+// snake-book searched, so the deadline doesn't apply to it.
+class SearchController : public IController
+{
+    public:
+        explicit SearchController(int threadCount) : search(threadCount) {}
+        
+        const char* Name() const override { return "SEARCH"; }
+        
+    protected:
+        Cell Choose(const GameState& state, int player, Clock::time_point deadline) override;
+        
+    private:
+        AlphaBetaSearch search;
+};
+
+// Plays book moves in known 0-0 openings, like SearchController, otherwise
+// plays out until the deadline
+class MonteCarloController : public IController
+{
+    public:
+        explicit MonteCarloController(int threadCount) : search(threadCount) {}
+        
+        const char* Name() const override { return "MCTS"; }
+        
+    protected:
+        Cell Choose(const GameState& state, int player, Clock::time_point deadline) override;
+        
+    private:
+        MonteCarloSearch search;
+};
+
+// Heuristic AI with the weights snake-tune found
+class TunedController : public IController
+{
+    public:
+        explicit TunedController(const AIWeights& weights) : ai(weights) {}
+        
+        const char* Name() const override { return "TUNED"; }
+        
+    protected:
+        Cell Choose(const GameState& state, int player, Clock::time_point deadline) override;
+        
+    private:
+        WeightedAI ai;
+};
+
+// Learned policy network; plays like GREEDY until a network is loaded
+class PolicyController : public IController
+{
+    public:
+        explicit PolicyController(const PolicyNetwork& network) : network(network) {}
+        
+        const char* Name() const override { return "NEURAL"; }
+        
+    protected:
+        Cell Choose(const GameState& state, int player, Clock::time_point deadline) override;
+        
+    private:
+        const PolicyNetwork& network;
+        PolicyNetwork::Scratch scratch; // Reused every decision, so deciding doesn't allocate
+};
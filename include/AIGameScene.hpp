@@ -1,5 +1,7 @@
 #pragma once
 #include "Scene.hpp"
+#include "ControllerDriver.hpp"
+#include "KeyboardController.hpp"
 #include "Game.hpp"
 #include "Global.hpp"
 #include <memory>
@@ -18,17 +20,16 @@ class AIGameScene : public Scene
     private:
         std::unique_ptr<Game> game;
         std::unique_ptr<Global> global;
+        std::shared_ptr<KeyboardController> keyboard;
+        ControllerDriver playerDriver;
+        ControllerDriver aiDriver;
         
         double gameUpdateInterval;
         bool waitingForPlayer;
         float readyPulseTimer;
-        
-        Vector2 playerNextDirection;
-        bool playerDirectionChanged;
+        int aiKind; // IController kind of the opponent, cycled with TAB
         
         void DrawUI() const;
         void DrawReadyScreen() const;
-        void HandlePlayerInput();
         void CheckReadyInput();
-        void UpdateAI();
 };
@@ -0,0 +1,39 @@
+#pragma once
+
+// Weights of the heuristic AI (WeightedAI), tuned offline by snake-tune.
+// Stored as a text file of "name value" lines that the game reads at
+// startup; missing names keep their defaults.
+struct AIWeights
+{
+    public:
+        static const int count = 4;
+        static constexpr const char* defaultPath = "ai-weights.txt";
+        
+        float food;     // Per step closer to the food
+        float space;    // Per reachable cell, up to WeightedAI::spaceCap
+        float trapped;  // Penalty for a move into less room than the body needs
+        float opponent; // Penalty per step closer than WeightedAI::nearOpponent to the other head
+        
+        static AIWeights Defaults() { return AIWeights{1.0f, 0.2f, 50.0f, 2.0f}; }
+        
+        // The weights as a vector, for the tuner
+        float& operator[](int i) { return this->*Member(i); }
+        float operator[](int i) const { return this->*Member(i); }
+        static const char* Name(int i);
+        
+        bool Load(const char* path); // false, weights unchanged, if unreadable
+        bool Save(const char* path) const;
+        
+        static AIWeights active; // What new TUNED controllers play with; main() loads it
+        
+    private:
+        static float AIWeights::* Member(int i)
+        {
+            static constexpr float AIWeights::* members[count] = {
+                &AIWeights::food, &AIWeights::space, &AIWeights::trapped, &AIWeights::opponent
+            };
+            return members[i];
+        }
+};
+
+inline AIWeights AIWeights::active = AIWeights::Defaults();
@@ -1,5 +1,6 @@
 #pragma once
 #include "Scene.hpp"
+#include "ControllerDriver.hpp"
 #include "Game.hpp"
 #include "Global.hpp"
 #include <memory>
@@ -18,15 +19,18 @@ class AIvsAIScene : public Scene
     private:
         std::unique_ptr<Game> game;
         std::unique_ptr<Global> global;
+        ControllerDriver driver1;
+        ControllerDriver driver2;
         
         double gameUpdateInterval;
         bool waitingToStart;
         float startPulseTimer;
         float deathDelayTimer;
         bool inDeathDelay;
+        int ai1Kind; // IController kinds; keys 1 and 2 step through them
+        int ai2Kind;
         
         void DrawUI() const;
+        void HandleAISelection();
         void DrawStartScreen() const;
-        void UpdateAI1();
-        void UpdateAI2();
 };
@@ -0,0 +1,58 @@
+#pragma once
+#include "Cell.hpp"
+#include "GameState.hpp"
+#include "ThreadPool.hpp"
+#include "TranspositionTable.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+struct SearchResult
+{
+    Cell move;     // Best move found; the current direction if none
+    int depth;     // Deepest search that finished, in ticks
+    int score;     // From the searching snake's point of view
+    int64_t nodes; // Positions stepped, over all iterations and threads
+};
+
+// Adversarial search AI for one snake. Both snakes really move at once; the
+// search treats each tick as "we pick, then the opponent picks knowing our
+// move", which is pessimistic but lets plain alpha-beta apply. Iterative
+// deepening runs until the deadline and returns the deepest finished result.
+//
+// With more than one thread the search is Lazy SMP: every thread runs the
+// same iterative deepening on the shared lock-free transposition table,
+// helpers starting at staggered depths, so they fill the table with results
+// the others pick up instead of dividing the tree explicitly.
+class AlphaBetaSearch
+{
+    public:
+        static const int maxDepth = 32;
+        static const int winScore = 1000000;
+        
+        // threadCount 0 = one per hardware thread
+        explicit AlphaBetaSearch(int threadCount = 1, int tableSizeLog2 = 18);
+        ~AlphaBetaSearch();
+        
+        AlphaBetaSearch(const AlphaBetaSearch&) = delete;
+        AlphaBetaSearch& operator=(const AlphaBetaSearch&) = delete;
+        
+        // player is 1 or 2; timeBudget in seconds. Returns by the deadline,
+        // with every helper thread stopped.
+        SearchResult Search(const GameState& state, int player, double timeBudget);
+        
+        int ThreadCount() const { return static_cast<int>(workers.size()); }
+        
+    private:
+        using Clock = std::chrono::steady_clock;
+        
+        class Worker; // Per-thread search state, see AlphaBetaSearch.cpp
+        
+        TranspositionTable table;
+        std::vector<std::unique_ptr<Worker>> workers; // workers[0] runs on the caller
+        std::unique_ptr<ThreadPool> helpers;
+        std::atomic<bool> stop;
+        Clock::time_point deadline;
+};
@@ -0,0 +1,40 @@
+#pragma once
+#include "Cell.hpp"
+#include <cstdint>
+
+// One bit per board cell (25x25 = 625 bits in ten 64-bit words).
+// Gives O(1) occupancy tests in place of linear body scans.
+class Bitboard
+{
+    public:
+        static const int cellCount = 25;
+        static const int cellTotal = cellCount * cellCount;
+        static const int wordCount = (cellTotal + 63) / 64;
+        
+        static bool InBounds(Cell cell)
+        {
+            return cell.x >= 0 && cell.x < cellCount && cell.y >= 0 && cell.y < cellCount;
+        }
+        
+        static int Index(Cell cell) { return cell.y * cellCount + cell.x; }
+        
+        void Clear()
+        {
+            for (int i = 0; i < wordCount; i++)
+                words[i] = 0;
+        }
+        
+        // Callers must pass in-bounds cells to Set/Reset; Test accepts any cell
+        void Set(Cell cell) { int i = Index(cell); words[i >> 6] |= uint64_t{1} << (i & 63); }
+        void Reset(Cell cell) { int i = Index(cell); words[i >> 6] &= ~(uint64_t{1} << (i & 63)); }
+        
+        bool Test(Cell cell) const
+        {
+            if (!InBounds(cell))
+                return false;
+            int i = Index(cell);
+            return (words[i >> 6] >> (i & 63)) & 1;
+        }
+        
+        uint64_t words[wordCount];
+};
@@ -0,0 +1,18 @@
+#pragma once
+
+// Integer grid coordinate used by the rules engine (no raylib dependency)
+struct Cell
+{
+    int x;
+    int y;
+};
+
+inline bool operator==(Cell a, Cell b) { return a.x == b.x && a.y == b.y; }
+inline bool operator!=(Cell a, Cell b) { return !(a == b); }
+inline Cell operator+(Cell a, Cell b) { return Cell{a.x + b.x, a.y + b.y}; }
+
+// The four moves, indexed by their move code: 0 = up, 1 = down, 2 = left,
+// 3 = right. Replays, the vector environment, the policy network's outputs
+// and the opening book all store moves as these codes, so the order is part
+// of their file formats.
+inline constexpr Cell DIRECTIONS[4] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
@@ -0,0 +1,28 @@
+#pragma once
+#include "DecisionWorker.hpp"
+#include "GameState.hpp"
+#include "IController.hpp"
+#include <memory>
+
+// Steers one snake of a game with an IController, once per tick. Call
+// Apply() just before each tick and Request() just after it: controllers
+// that think ahead do so on a DecisionWorker in between, with a deadline
+// half a tick away; the others decide inside Apply().
+class ControllerDriver
+{
+    public:
+        explicit ControllerDriver(int player);
+        
+        // Takes effect from the next Request(); a decision in progress
+        // finishes on the old controller first
+        void SetController(std::shared_ptr<IController> newController);
+        IController* Controller() const { return controller.get(); }
+        
+        void Request(const GameState& state, double tickInterval);
+        void Apply(GameState& state);
+        
+    private:
+        int player;
+        std::shared_ptr<IController> controller;
+        DecisionWorker worker; // Last: stopped before the controller is released
+};
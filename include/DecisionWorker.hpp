@@ -0,0 +1,50 @@
+#pragma once
+#include "Cell.hpp"
+#include "GameState.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// Runs one AI's decisions on a thread of its own so a slow AI never holds
+// up a frame. Request() hands it a snapshot of the state right after a tick;
+// the AI thinks while the frames in between are drawn, and TryTake() picks
+// the move up at the next tick without ever waiting for it.
+class DecisionWorker
+{
+    public:
+        using Decide = std::function<Cell(const GameState& state)>;
+        
+        DecisionWorker();
+        ~DecisionWorker(); // Waits for a decision in progress to finish
+        
+        DecisionWorker(const DecisionWorker&) = delete;
+        DecisionWorker& operator=(const DecisionWorker&) = delete;
+        
+        // Decide a move for state on the worker thread. Replaces the previous
+        // request: a move still being computed for it is never published.
+        void Request(const GameState& state, Decide decide);
+        
+        // The move for the latest request, once; false if not published yet
+        bool TryTake(Cell& move);
+        
+        void Cancel(); // Forget the latest request, e.g. when a round ends
+        
+    private:
+        void Loop();
+        
+        std::mutex stateMutex;
+        std::condition_variable workAvailable;
+        
+        GameSnapshot pending;  // Snapshot for the next decision
+        Decide pendingDecide;
+        bool hasPending;
+        uint64_t requested;    // Number of the latest request
+        
+        Cell result;
+        bool resultReady;      // result answers the latest request
+        bool stopping;
+        
+        std::thread worker;    // Last, so it starts after the fields above
+};
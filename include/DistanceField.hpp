@@ -0,0 +1,46 @@
+#pragma once
+#include "Bitboard.hpp"
+#include "Cell.hpp"
+#include "FloodFill.hpp"
+#include "GameState.hpp"
+#include <cstdint>
+
+// Shortest-path AI: one breadth-first search from the food over the cells
+// neither snake covers gives every free cell its distance to the food, and
+// both AIs then read their move off the same field. All buffers are fixed
+// arrays, so Compute never allocates.
+class DistanceField
+{
+    public:
+        static const int unreachable = -1;
+        
+        DistanceField();
+        
+        void Compute(const GameState& state); // Call once per tick, before steering
+        
+        int At(Cell cell) const
+        {
+            if (!Bitboard::InBounds(cell))
+                return unreachable;
+            int d = distance[Padded(cell)];
+            return d >= 0 ? d : unreachable;
+        }
+        
+        // Step towards the food along a shortest path, avoiding moves into
+        // pockets too small to hold the snake. Without a safe path to the
+        // food, the step with the most room; {0, 0} if every step is fatal.
+        Cell BestMove(const Snake& snake) const;
+        
+    private:
+        // The board plus a one-cell wall border, so the search needs no
+        // bounds checks: neighbours are always at +-1 and +-stride
+        static const int stride = Bitboard::cellCount + 2;
+        static const int paddedTotal = stride * stride;
+        
+        static int Padded(Cell cell) { return (cell.y + 1) * stride + cell.x + 1; }
+        
+        int16_t distance[paddedTotal]; // Steps to the food, unreachable, or wall
+        int16_t queue[Bitboard::cellTotal];
+        Bitboard blocked; // Cells covered by either snake when last computed
+        FloodFill floodFill;
+};
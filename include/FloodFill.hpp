@@ -0,0 +1,54 @@
+#pragma once
+#include "Bitboard.hpp"
+#include "Cell.hpp"
+#include "GameState.hpp"
+#include <cstdint>
+
+// How much room a cell leads to
+struct ReachableArea
+{
+    int area;  // Free cells reachable from the start, start included
+    int depth; // Distance of the farthest of them (0 = just the start)
+};
+
+// Bit-parallel flood fill. The board is kept one row per 32-bit word, so a
+// whole BFS layer grows in one pass over the rows: left/right neighbours are
+// a shift by one and up/down neighbours are the adjacent row. Rows are
+// processed eight at a time in AVX2 registers when the CPU has them, four at
+// a time in SSE2/NEON registers otherwise, so a fill costs a few dozen
+// instructions per distance layer rather than work per cell.
+class FloodFill
+{
+    public:
+        FloodFill();
+        
+        void Load(const GameState& state); // Free cells = not covered by either snake
+        
+        // Cells reachable from start through free cells. If layerSizes is
+        // given it receives the number of cells at each distance (depth + 1
+        // entries; Bitboard::cellTotal is always enough).
+        ReachableArea Fill(Cell start, int* layerSizes = nullptr) const;
+        
+        // Fill from each of the snake's four next cells, in GetAIDirection's
+        // order (up, down, left, right). Reversing or blocked moves get {0, 0}.
+        void EvaluateMoves(const Snake& snake, ReachableArea areas[4]) const;
+        
+        bool IsFree(Cell cell) const
+        {
+            return Bitboard::InBounds(cell) && ((open[Slot(cell.y)] >> cell.x) & 1);
+        }
+        
+    private:
+        // Rows are interleaved across 8-lane blocks (one AVX2 register
+        // each): board row y lives in block y % blockCount, lane
+        // y / blockCount. The row above or below is then the same lane of
+        // the neighbouring block, and only the first and last blocks need a
+        // lane shift. Rows past the board stay empty.
+        static const int blockRows = 8;
+        static const int blockCount = (Bitboard::cellCount + blockRows - 1) / blockRows;
+        static const int rowCount = blockCount * blockRows;
+        
+        static int Slot(int y) { return (y % blockCount) * blockRows + y / blockCount; }
+        
+        alignas(32) uint32_t open[rowCount];
+};
@@ -1,21 +1,14 @@
 #pragma once
-#include "raylib.h"
-#include <deque>
+#include "Cell.hpp"
+#include "FreeCells.hpp"
+#include "Random.hpp"
 
 class Food
 {
     public:
-        Food(const std::deque<Vector2>& snakeBody, int cellCount);
-        ~Food();
+        Food();
         
-        void Draw(int cellSize, int borderSize) const;
-        Vector2 GenerateRandomPos(const std::deque<Vector2>& snakeBody);
+        Cell GenerateRandomPos(const FreeCells& freeCells, Random& rng) const;
         
-        Vector2 position;
-    
-    private:
-        Vector2 GenerateRandomCell() const;
-        
-        Texture2D texture;
-        int cellCount;
-};
\ No newline at end of file
+        Cell position;
+};
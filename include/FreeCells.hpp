@@ -0,0 +1,77 @@
+#pragma once
+#include "Bitboard.hpp"
+#include "Cell.hpp"
+#include "Snake.hpp"
+#include <cstdint>
+
+// Dense list of the cells no snake occupies, with a reverse index so a cell
+// can be added or swap-removed in O(1). Lets food spawn with a single random
+// pick regardless of how full the board is.
+class FreeCells
+{
+    public:
+        int Count() const { return count; }
+        
+        Cell At(int i) const
+        {
+            return Cell{cells[i] % Bitboard::cellCount, cells[i] / Bitboard::cellCount};
+        }
+        
+        bool Contains(Cell cell) const
+        {
+            return Bitboard::InBounds(cell) && position[Bitboard::Index(cell)] >= 0;
+        }
+        
+        void Add(Cell cell)
+        {
+            int index = Bitboard::Index(cell);
+            if (position[index] >= 0)
+                return;
+            
+            cells[count] = static_cast<int16_t>(index);
+            position[index] = static_cast<int16_t>(count);
+            count++;
+        }
+        
+        void Remove(Cell cell)
+        {
+            int index = Bitboard::Index(cell);
+            int slot = position[index];
+            if (slot < 0)
+                return;
+            
+            // Move the last entry into the vacated slot
+            count--;
+            int16_t last = cells[count];
+            cells[slot] = last;
+            position[last] = static_cast<int16_t>(slot);
+            position[index] = -1;
+        }
+        
+        void Rebuild(const Snake& a, const Snake& b)
+        {
+            count = 0;
+            
+            for (int y = 0; y < Bitboard::cellCount; y++)
+            {
+                for (int x = 0; x < Bitboard::cellCount; x++)
+                {
+                    Cell cell{x, y};
+                    int index = Bitboard::Index(cell);
+                    position[index] = -1;
+                    
+                    if (!a.Occupies(cell) && !b.Occupies(cell))
+                    {
+                        cells[count] = static_cast<int16_t>(index);
+                        position[index] = static_cast<int16_t>(count);
+                        count++;
+                    }
+                }
+            }
+        }
+        
+    private:
+        int16_t cells[Bitboard::cellTotal];    // free cell indices, densely packed
+        int16_t position[Bitboard::cellTotal]; // slot of each cell in cells, or -1
+        int count = 0;
+};
@@ -1,43 +1,43 @@
 #pragma once
-#include "Food.hpp"
-#include "Snake.hpp"
+#include "GameState.hpp"
+#include "Replay.hpp"
+#include "SimClock.hpp"
 #include "raylib.h"
+#include <cstdint>
 
-class Game
+// Presentation wrapper around the headless GameState: owns the textures,
+// sounds and music and draws the board.
+class Game : public GameState
 {
     public:
         Game();
         Game(bool enableSounds);
+        Game(bool enableSounds, uint64_t seed);
         ~Game();
         
         void Draw() const;
         void Update();
-        void GameOver();
+        void BeginRound(); // Fresh seed, starting position and replay recording
         
-        // Game constants
+        // Rendering constants
         static const int cellSize = 30;
-        static const int cellCount = 25;
         static const int borderSize = 75;
         
-        // Game objects
-        Snake player1;
-        Snake player2;
-        Food food;
-        
-        // Game state
-        int score;
-        int score2;
-        bool running;
         bool soundsEnabled;
-        int winner; // 0 = no winner yet, 1 = player1, 2 = player2, 3 = tie
+        SimClock clock; // Per-game fixed-step clock driving Update()
         
     private:
-        void CheckCollisionWithFood();
-        void CheckCollisionWithEdges();
-        void CheckCollisionWithTail();
-        void DeclareWinner(int winnerNum);
+        void LoadSounds();
+        void SubmitReplay(int result);
+        void DrawSnake(const Snake& snake, Color snakeColor) const;
+        
+        // Graphics
+        Texture2D foodTexture;
+        
+        // Replay of the current round, sent to Global::replayWriter when it ends
+        ReplayRecorder recorder;
         
         // Audio
         Sound consumptionSound;
         Sound deathSound;
-};
\ No newline at end of file
+};
@@ -1,5 +1,7 @@
 #pragma once
 #include "Scene.hpp"
+#include "ControllerDriver.hpp"
+#include "KeyboardController.hpp"
 #include "Game.hpp"
 #include "Global.hpp"
 #include <memory>
@@ -18,18 +20,16 @@ class GameScene : public Scene
     private:
         std::unique_ptr<Game> game;
         std::unique_ptr<Global> global;
+        std::shared_ptr<KeyboardController> keyboard1;
+        std::shared_ptr<KeyboardController> keyboard2;
+        ControllerDriver driver1;
+        ControllerDriver driver2;
         
         double gameUpdateInterval;
         bool waitingForPlayers;
         float readyPulseTimer;
         
-        Vector2 player1NextDirection;
-        Vector2 player2NextDirection;
-        bool player1DirectionChanged;
-        bool player2DirectionChanged;
-        
         void DrawUI() const;
         void DrawReadyScreen() const;
-        void HandleInput();
         void CheckReadyInput();
 };
@@ -0,0 +1,89 @@
+#pragma once
+#include "Food.hpp"
+#include "FreeCells.hpp"
+#include "Random.hpp"
+#include "Snake.hpp"
+#include "Zobrist.hpp"
+#include <cstdint>
+#include <type_traits>
+
+// What happened during a single tick, so the presentation layer can react
+// (sounds, music) without the rules engine knowing about raylib.
+struct TickEvents
+{
+    bool player1Ate;
+    bool player2Ate;
+    bool gameOver;
+};
+
+class GameState;
+
+// A saved copy of the full rules state: both snakes, food, scores, winner,
+// rng and free-cell list. Fixed size with no heap, so saving and restoring
+// is a plain 5.3 KB copy and a restored game plays on exactly as the
+// original would (same food spawns).
+//
+// The free-cell list stays in the snapshot on purpose: food spawns pick by
+// index into it, so its order is part of the game, and rebuilding it costs
+// more than the whole copy. `snake-batch ... snapshot` measures both (about
+// 110 ns per restore and 250 ns per copy-and-step search node, against
+// 1.2 us per free-list rebuild).
+using GameSnapshot = GameState;
+
+// Headless rules engine: both snakes, food, scores and winner.
+// Has no raylib dependency and can be stepped without a window or audio device.
+class GameState
+{
+    public:
+        GameState();
+        explicit GameState(uint64_t seed);
+        
+        // Advances one tick. Performs no heap allocations: bodies are fixed
+        // ring buffers and collisions are bitboard tests; `make test` fails if
+        // a steady-state Step allocates.
+        TickEvents Step();
+        void ResetRound();
+        void NewRound(uint64_t newSeed); // Reseed and return to the starting position
+        int OwnerAt(Cell cell) const; // 0 = empty, 1 = player1, 2 = player2
+        
+        // Zobrist key of the position (both snakes and the food), O(1)
+        uint64_t Hash() const
+        {
+            return player1.Hash() ^ Zobrist::Opponent(player2.Hash()) ^ Zobrist::Food(food.position);
+        }
+        
+        // Snapshots for lookahead search, rollback and replay keyframes.
+        // Only the rules state is copied, so this is safe on a Game too.
+        GameSnapshot Save() const { return *this; }
+        void Restore(const GameSnapshot& snapshot) { *this = snapshot; }
+        
+        // Board size in cells and default seconds per tick
+        static const int cellCount = Bitboard::cellCount;
+        static constexpr double tickInterval = 0.2;
+        
+        // Game objects
+        Snake player1;
+        Snake player2;
+        Food food;
+        
+        // Game state
+        int score;
+        int score2;
+        bool running;
+        int winner; // 0 = no winner yet, 1 = player1, 2 = player2, 3 = tie
+        uint64_t seed; // Seed of rng; same seed and inputs replay the same game
+        
+    private:
+        void CheckCollisionWithFood();
+        void CheckCollisionWithEdges();
+        void CheckCollisionWithTail();
+        void DeclareWinner(int winnerNum);
+        void SyncFreeCell(Cell cell);
+        
+        Random rng;
+        FreeCells freeCells; // cells not covered by either snake, for food spawns
+        TickEvents events;
+};
+
+static_assert(std::is_trivially_copyable<GameState>::value,
+              "GameState must stay trivially copyable for cheap snapshots");
@@ -1,6 +1,7 @@
 #pragma once
+#include "ReplayWriter.hpp"
 #include "raylib.h"
-#include <deque>
+#include <memory>
 
 class Global
 {
@@ -9,8 +10,5 @@ class Global
         inline static Color foodColor = RED;
         inline static Color backgroundColor = Color{40, 40, 40, 255};
         inline static Music easyAndNormalModeMusic = LoadMusicStream("Assets/Sounds/Music/Breaking News by SAKUMAMATATA.mp3");
-        inline static double lastUpdateTime = 0;
-        
-        static bool EventTriggered(double interval);
-        static bool ElementInDeque(Vector2 element, const std::deque<Vector2>& deque);
+        inline static std::unique_ptr<ReplayWriter> replayWriter; // Set up in main()
 };
\ No newline at end of file
@@ -0,0 +1,131 @@
+#pragma once
+#include "Bitboard.hpp"
+#include "Cell.hpp"
+#include "Snake.hpp"
+#include <cstdint>
+
+// Reference AI that follows a fixed Hamiltonian cycle of the board, taking
+// shortcuts towards the food only while they cannot cut off its own tail.
+// Following the cycle alone can never hit itself, so on its own it fills the
+// board; the cycle and every cell's neighbour positions are built at compile
+// time, and a decision is a few table lookups and comparisons.
+//
+// An odd-sized board has no Hamiltonian cycle (the grid is bipartite), so
+// there the cycle skips the bottom-right corner. The corner shares the cycle
+// position of its diagonal neighbour: both lie between the same two cycle
+// cells, so each lap can pass through either one.
+class HamiltonianCycle
+{
+    public:
+        static const int length = Bitboard::cellTotal - (Bitboard::cellCount % 2);
+        static const int offCycle = -1;
+        
+        // Index of cell along the cycle, or offCycle off the board
+        static int Position(Cell cell)
+        {
+            return Bitboard::InBounds(cell) ? tables.position[Bitboard::Index(cell)] : offCycle;
+        }
+        
+        static Cell At(int position)
+        {
+            int index = tables.order[position];
+            return Cell{index % Bitboard::cellCount, index / Bitboard::cellCount};
+        }
+        
+        // Steps from one position forward to another along the cycle
+        static int Ahead(int from, int to) { return (to - from + length) % length; }
+        
+        // Next move for snake; {0, 0} if every step is fatal
+        static Cell BestMove(const Snake& snake, const Snake& opponent, Cell food);
+        
+    private:
+        static const int size = Bitboard::cellCount;
+        
+        struct Tables
+        {
+            int16_t order[Bitboard::cellTotal];         // Cell index at each cycle position
+            int16_t position[Bitboard::cellTotal];      // Cycle position of each cell
+            int16_t neighbours[Bitboard::cellTotal][4]; // Positions of the cells up, down, left, right
+            int count;                                  // Cells visited walking the cycle
+        };
+        
+        static constexpr int Index(int x, int y) { return y * size + x; }
+        
+        // Column 0 runs down, columns 1 .. width-1 snake up and down over rows
+        // 1 .. size-1, and row 0 runs back to the start, where width is the
+        // largest even column count. On odd boards the last column is spliced
+        // in two cells at a time beside the column before it.
+        static constexpr Tables MakeTables()
+        {
+            int next[Bitboard::cellTotal] = {};
+            for (int i = 0; i < Bitboard::cellTotal; i++) next[i] = -1;
+            
+            int width = size - size % 2;
+            
+            for (int y = 0; y < size - 1; y++) next[Index(0, y)] = Index(0, y + 1);
+            next[Index(0, size - 1)] = Index(1, size - 1);
+            
+            for (int x = 1; x < width; x++)
+            {
+                if (x % 2 == 1)
+                {
+                    for (int y = size - 1; y > 1; y--) next[Index(x, y)] = Index(x, y - 1);
+                    next[Index(x, 1)] = (x < width - 1) ? Index(x + 1, 1) : Index(x, 0);
+                }
+                else
+                {
+                    for (int y = 1; y < size - 1; y++) next[Index(x, y)] = Index(x, y + 1);
+                    next[Index(x, size - 1)] = Index(x + 1, size - 1);
+                }
+            }
+            
+            for (int x = width - 1; x > 0; x--) next[Index(x, 0)] = Index(x - 1, 0);
+            
+            if (size % 2 == 1)
+            {
+                for (int y = size - 2; y > 0; y -= 2)
+                {
+                    next[Index(width - 1, y)] = Index(size - 1, y);
+                    next[Index(size - 1, y)] = Index(size - 1, y - 1);
+                    next[Index(size - 1, y - 1)] = Index(width - 1, y - 1);
+                }
+            }
+            
+            Tables result{};
+            for (int i = 0; i < Bitboard::cellTotal; i++) result.position[i] = offCycle;
+            
+            int cell = 0;
+            do
+            {
+                result.order[result.count] = static_cast<int16_t>(cell);
+                result.position[cell] = static_cast<int16_t>(result.count);
+                result.count++;
+                cell = next[cell];
+            }
+            while (cell > 0 && result.count < Bitboard::cellTotal);
+            
+            if (size % 2 == 1)
+            {
+                result.position[Index(size - 1, size - 1)] = result.position[Index(size - 2, size - 2)];
+            }
+            
+            for (int y = 0; y < size; y++)
+            {
+                for (int x = 0; x < size; x++)
+                {
+                    int16_t* neighbours = result.neighbours[Index(x, y)];
+                    neighbours[0] = y > 0 ? result.position[Index(x, y - 1)] : offCycle;
+                    neighbours[1] = y < size - 1 ? result.position[Index(x, y + 1)] : offCycle;
+                    neighbours[2] = x > 0 ? result.position[Index(x - 1, y)] : offCycle;
+                    neighbours[3] = x < size - 1 ? result.position[Index(x + 1, y)] : offCycle;
+                }
+            }
+            
+            return result;
+        }
+        
+        static const Tables tables;
+};
+
+// Constant-initialized: the tables are baked into the binary
+inline const HamiltonianCycle::Tables HamiltonianCycle::tables = HamiltonianCycle::MakeTables();
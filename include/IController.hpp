@@ -0,0 +1,62 @@
+#pragma once
+#include "Cell.hpp"
+#include "GameState.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+// Decision times of one controller, in seconds
+struct DecisionLatency
+{
+    double last;
+    double mean;
+    double max;
+    int64_t count;
+};
+
+// Steers one snake: a person at the keyboard or one of the AIs. Every
+// decision gets a deadline (the controller should return by then) and is
+// timed, so controllers can be compared on cost as well as strength.
+class IController
+{
+    public:
+        using Clock = std::chrono::steady_clock;
+        
+        // AI controllers Create() can build
+        static const int kindGreedy = 0; // Snake::GetAIDirection
+        static const int kindPath = 1;   // DistanceField shortest path
+        static const int kindCycle = 2;  // HamiltonianCycle
+        static const int kindSearch = 3; // AlphaBetaSearch
+        static const int kindMCTS = 4;   // MonteCarloSearch
+        static const int kindTuned = 5;  // WeightedAI with AIWeights::active
+        static const int kindPolicy = 6; // PolicyNetwork::active
+        static const int kindCount = 7;
+        
+        // threadCount is for the searching AIs; 0 = one per hardware thread
+        static std::unique_ptr<IController> Create(int kind, int threadCount = 1);
+        
+        virtual ~IController() = default;
+        
+        // Move for player (1 or 2); {0, 0} keeps the current direction.
+        // Safe to call from any one thread at a time.
+        Cell Decide(const GameState& state, int player, Clock::time_point deadline);
+        
+        virtual const char* Name() const = 0;
+        
+        // Decided on the spot at each tick (people), instead of thinking
+        // ahead between ticks on a worker thread
+        virtual bool DecidesAtTick() const { return false; }
+        
+        DecisionLatency Latency() const; // Any thread
+        
+    protected:
+        virtual Cell Choose(const GameState& state, int player, Clock::time_point deadline) = 0;
+        
+    private:
+        // Nanoseconds; written by the deciding thread, read by any
+        std::atomic<int64_t> lastNanoseconds{0};
+        std::atomic<int64_t> maxNanoseconds{0};
+        std::atomic<int64_t> totalNanoseconds{0};
+        std::atomic<int64_t> decisions{0};
+};
@@ -0,0 +1,23 @@
+#pragma once
+#include "IController.hpp"
+
+// A person steering with four keys. Poll() every frame buffers the first
+// valid turn pressed since the last tick; the tick then takes it.
+class KeyboardController : public IController
+{
+    public:
+        KeyboardController(int upKey, int downKey, int leftKey, int rightKey);
+        
+        void Poll(const Snake& snake);
+        void Clear() { nextDirection = {0, 0}; } // Drop a buffered turn, e.g. between rounds
+        
+        const char* Name() const override { return "PLAYER"; }
+        bool DecidesAtTick() const override { return true; }
+        
+    protected:
+        Cell Choose(const GameState& state, int player, Clock::time_point deadline) override;
+        
+    private:
+        int keys[4]; // Up, down, left, right
+        Cell nextDirection; // {0, 0} if no turn is buffered
+};
@@ -1,5 +1,6 @@
 #pragma once
 #include "Scene.hpp"
+#include "ControllerDriver.hpp"
 #include "Game.hpp"
 #include "Global.hpp"
 #include "raylib.h"
@@ -23,12 +24,12 @@ class MainMenuScene : public Scene
         Color backgroundColor;
         Color titleColor;
         float titlePulseTimer;
-        int selectedOption; // 0=PvP, 1=PvAI, 2=AIvsAI, 3=Options, 4=Quit
+        int selectedOption; // 0=PvP, 1=PvAI, 2=AIvsAI, 3=Replays, 4=Options, 5=Quit
         
         // Background AI battle
         std::unique_ptr<Game> backgroundGame;
         std::unique_ptr<Global> backgroundGlobal;
+        ControllerDriver driver1;
+        ControllerDriver driver2;
         double gameUpdateInterval;
-        
-        void UpdateBackgroundAI();
 };
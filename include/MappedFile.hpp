@@ -0,0 +1,23 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Read-only memory mapping of a whole file (POSIX mmap)
+class MappedFile
+{
+    public:
+        explicit MappedFile(const std::string& path);
+        ~MappedFile();
+        
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        
+        bool IsOpen() const { return data != nullptr; }
+        const uint8_t* Data() const { return data; }
+        size_t Size() const { return size; }
+        
+    private:
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+};
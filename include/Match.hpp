@@ -0,0 +1,19 @@
+#pragma once
+#include "Replay.hpp"
+#include <cstdint>
+
+struct MatchResult
+{
+    int winner; // 0 = ran out of ticks, 1 = player1, 2 = player2, 3 = tie
+    int ticks;
+    int score1;
+    int score2;
+};
+
+// Headless AI vs AI match using the same steering as AIvsAIScene
+class Match
+{
+    public:
+        // Records the match into replay when given
+        static MatchResult PlayAIvsAI(uint64_t seed, int maxTicks, ReplayRecorder* replay = nullptr);
+};
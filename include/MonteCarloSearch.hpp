@@ -0,0 +1,51 @@
+#pragma once
+#include "Cell.hpp"
+#include "GameState.hpp"
+#include "ThreadPool.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+struct MonteCarloResult
+{
+    Cell move;        // Most visited move; the current direction if none
+    double value;     // Mean playout reward of that move, 0 = loss .. 1 = win
+    int64_t playouts; // Over all threads
+};
+
+// Monte Carlo tree search AI for one snake. Both snakes move at once, so
+// selection is decoupled UCT: every node keeps separate move statistics per
+// snake, each snake picks its own move by UCB1 and the pair selects the
+// child. Leaves are scored by a playout with a fast greedy/random policy.
+//
+// Threads search independent trees from the same root (root parallelism),
+// each with its own RNG and a preallocated node arena, and their root move
+// counts are summed. Nothing is shared while searching, so playouts/sec
+// scales with the thread count.
+class MonteCarloSearch
+{
+    public:
+        // threadCount 0 = one per hardware thread
+        explicit MonteCarloSearch(int threadCount = 1, int nodesPerThread = 1 << 15);
+        ~MonteCarloSearch();
+        
+        MonteCarloSearch(const MonteCarloSearch&) = delete;
+        MonteCarloSearch& operator=(const MonteCarloSearch&) = delete;
+        
+        // player is 1 or 2; timeBudget in seconds. Returns by the deadline,
+        // with every helper thread stopped.
+        MonteCarloResult Search(const GameState& state, int player, double timeBudget);
+        
+        int ThreadCount() const { return static_cast<int>(workers.size()); }
+        
+    private:
+        using Clock = std::chrono::steady_clock;
+        
+        class Worker; // Per-thread tree and RNG, see MonteCarloSearch.cpp
+        
+        std::vector<std::unique_ptr<Worker>> workers; // workers[0] runs on the caller
+        std::unique_ptr<ThreadPool> helpers;
+        Clock::time_point deadline;
+};
@@ -0,0 +1,39 @@
+#pragma once
+#include "GameState.hpp"
+#include <cstdint>
+#include <cstring>
+
+// One snake's view of the board as bit-planes: own body, opponent body,
+// both heads, food. Each plane is a Bitboard's words (bit y * cellCount + x).
+// This is what the C vector environment returns and what PolicyNetwork reads,
+// so a policy trained on the one plays unchanged in the game.
+class Observation
+{
+    public:
+        static const int planeCount = 4;
+        static const int wordCount = planeCount * Bitboard::wordCount;
+        
+        static void Write(const GameState& state, int player, uint64_t* words)
+        {
+            const Snake& own = player == 1 ? state.player1 : state.player2;
+            const Snake& other = player == 1 ? state.player2 : state.player1;
+            
+            Bitboard heads;
+            Bitboard food;
+            heads.Clear();
+            food.Clear();
+            for (Cell cell : {state.player1.body[0], state.player2.body[0]})
+            {
+                if (Bitboard::InBounds(cell))
+                    heads.Set(cell);
+            }
+            if (Bitboard::InBounds(state.food.position))
+                food.Set(state.food.position);
+            
+            const Bitboard* planes[planeCount] = {&own.Occupancy(), &other.Occupancy(), &heads, &food};
+            for (int plane = 0; plane < planeCount; plane++)
+            {
+                memcpy(words + plane * Bitboard::wordCount, planes[plane]->words, sizeof(planes[plane]->words));
+            }
+        }
+};
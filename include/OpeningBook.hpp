@@ -0,0 +1,57 @@
+#pragma once
+#include "Cell.hpp"
+#include "MappedFile.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Precomputed best moves for early positions, keyed by GameState::Hash().
+// Every round starts from the same snake positions and only the food differs,
+// so until the first food is eaten the searching AIs meet the same positions
+// game after game; snake-book searches them offline and the AIs look them up
+// instead of searching again.
+//
+// Every entry is a 0-0 position: snake-book stops each line at the first
+// food, and the hash doesn't cover the scores, so callers only probe while
+// neither snake has eaten. Moves were searched for snake-book's budget (20 ms
+// by default); a book hit is played as is, whatever the caller's deadline.
+//
+// The file is a 16-byte header ("SNOB", uint32 version, uint64 entry count)
+// followed by Entry records sorted by hash. Opening it maps the file and
+// checks the header; lookups are a binary search straight in the mapping.
+class OpeningBook
+{
+    public:
+        static constexpr const char* defaultPath = "opening-book.bin";
+        static const uint8_t noMove = 0xFF;
+        
+        struct Entry
+        {
+            uint64_t hash;
+            uint8_t moves[2]; // Per player: 0 = up, 1 = down, 2 = left, 3 = right, or noMove
+            uint8_t reserved[6];
+        };
+        
+        explicit OpeningBook(const std::string& path); // Empty if missing or malformed
+        
+        size_t Size() const { return count; }
+        
+        // Book move for player (1 or 2) in the position with this hash
+        bool Probe(uint64_t hash, int player, Cell& move) const;
+        
+        // Sorts entries (the last of equal hashes wins) and writes a book file
+        static bool Write(const char* path, std::vector<Entry> entries);
+        
+        static uint8_t MoveCode(Cell direction);
+        
+        static std::unique_ptr<const OpeningBook> active; // What the searching AIs probe; main() opens it
+        
+    private:
+        MappedFile file;
+        const Entry* entries = nullptr;
+        size_t count = 0;
+};
+
+inline std::unique_ptr<const OpeningBook> OpeningBook::active;
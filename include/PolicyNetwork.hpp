@@ -0,0 +1,78 @@
+#pragma once
+#include "GameState.hpp"
+#include "Observation.hpp"
+#include <cstdint>
+#include <vector>
+
+// Small fully connected policy network over Observation bit-planes, run on
+// the CPU in batches. Input i is cell i % cellTotal of plane i / cellTotal.
+// The first layer only adds the weight rows of set inputs (a few dozen of
+// 2500); later layers are dense. ReLU between layers; the four outputs are
+// logits for up, down, left, right. Kernels use AVX2/FMA when the CPU has
+// them and plain loops otherwise; the loops use std::fma in the same order,
+// so every CPU gets bit-identical logits (`make test` checks).
+//
+// Weights file (little-endian): "SNPN", uint32 version (1), uint32 layer
+// count L, uint32 widths[L + 1] (first inputCount, last outputCount), then per
+// layer float32 weights[inputs][outputs] followed by float32 bias[outputs].
+class PolicyNetwork
+{
+    public:
+        static const int inputCount = Observation::planeCount * Bitboard::cellTotal;
+        static const int outputCount = 4;
+        static const int maxLayers = 8;
+        static const int maxWidth = 4096;
+        static constexpr const char* defaultPath = "policy.bin";
+        
+        // Activations for Evaluate. Each caller keeps its own and reuses it:
+        // it grows to the largest batch seen and then never allocates again.
+        struct Scratch
+        {
+            std::vector<float> current;
+            std::vector<float> next;
+        };
+        
+        bool Load(const char* path); // false, network unchanged, if unreadable or malformed
+        bool Save(const char* path) const;
+        
+        // Random weights with these hidden layer widths (He initialisation),
+        // for benchmarks when no trained file is at hand
+        void Randomize(const std::vector<int>& hiddenWidths, uint64_t seed);
+        
+        bool IsLoaded() const { return !layers.empty(); }
+        
+        // logits[batch][outputCount] for batch observations of
+        // Observation::wordCount words each. Needs IsLoaded(); safe to call
+        // from many threads, each with its own scratch.
+        void Evaluate(const uint64_t* observations, int batch, float* logits, Scratch& scratch) const;
+        
+        // Highest-logit move that doesn't reverse or run into a wall or a
+        // body, if there is one
+        static Cell ChooseMove(const float* logits, const GameState& state, int player);
+        
+        static const char* KernelName(); // "avx2" or "scalar"
+        
+        // Switches every network to the named kernels; false, kernels
+        // unchanged, if this CPU can't run them. For comparing the two paths;
+        // not safe while any network is evaluating.
+        static bool UseKernels(const char* name);
+        
+        static PolicyNetwork active; // What new NEURAL controllers play with; main() loads it
+        
+    private:
+        struct Layer
+        {
+            int inputs;
+            int outputs;
+            int stride; // outputs rounded up to a multiple of 8, zero padded
+            std::vector<float> weights; // [inputs][stride]
+            std::vector<float> bias;    // [stride]
+        };
+        
+        static Layer MakeLayer(int inputs, int outputs);
+        
+        std::vector<Layer> layers;
+        int widest = 0; // Largest stride, for scratch buffers
+};
+
+inline PolicyNetwork PolicyNetwork::active;
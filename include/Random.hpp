@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <random>
+
+// Small, fast, per-instance PRNG (PCG32). Each game owns one, so games are
+// reproducible from their seed and can run on separate threads without
+// sharing state.
+class Random
+{
+    public:
+        explicit Random(uint64_t seed = 0) { Seed(seed); }
+        
+        void Seed(uint64_t seed)
+        {
+            state = 0;
+            increment = (STREAM << 1u) | 1u;
+            Next();
+            state += seed;
+            Next();
+        }
+        
+        uint32_t Next()
+        {
+            uint64_t old = state;
+            state = old * MULTIPLIER + increment;
+            uint32_t xorShifted = static_cast<uint32_t>(((old >> 18u) ^ old) >> 27u);
+            uint32_t rotation = static_cast<uint32_t>(old >> 59u);
+            return (xorShifted >> rotation) | (xorShifted << ((-rotation) & 31u));
+        }
+        
+        // Unbiased value in [0, bound) (Lemire's multiply-shift method)
+        uint32_t NextBelow(uint32_t bound)
+        {
+            uint64_t product = static_cast<uint64_t>(Next()) * bound;
+            uint32_t low = static_cast<uint32_t>(product);
+            
+            if (low < bound)
+            {
+                uint32_t threshold = -bound % bound;
+                while (low < threshold)
+                {
+                    product = static_cast<uint64_t>(Next()) * bound;
+                    low = static_cast<uint32_t>(product);
+                }
+            }
+            
+            return static_cast<uint32_t>(product >> 32);
+        }
+        
+        // Fresh nondeterministic seed for games that don't ask for one
+        static uint64_t MakeSeed()
+        {
+            std::random_device device;
+            return (static_cast<uint64_t>(device()) << 32) | device();
+        }
+        
+    private:
+        static const uint64_t MULTIPLIER = 6364136223846793005ULL;
+        static const uint64_t STREAM = 0xda3e39cb94b95bdbULL;
+        
+        uint64_t state;
+        uint64_t increment;
+};
@@ -0,0 +1,75 @@
+#pragma once
+#include "Cell.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Compact match replays: the seed plus each tick's pair of directions.
+//
+// Layout: "SNK" magic, version byte, board size byte, then varints for the
+// tick interval (microseconds), seed, tick count and winner, followed by runs
+// of identical ticks. Each run is one varint: (run length << 4) | directions,
+// where directions packs player 1 in bits 0-1 and player 2 in bits 2-3.
+// Directions are 0 = up, 1 = down, 2 = left, 3 = right.
+
+// LEB128 varints, shared by replays and the replay log
+class Varint
+{
+    public:
+        static void Append(std::vector<uint8_t>& out, uint64_t value);
+        static bool Read(const uint8_t*& cursor, const uint8_t* end, uint64_t& value);
+};
+
+struct ReplayHeader
+{
+    int cellCount;
+    double tickInterval;
+    uint64_t seed;
+    int tickCount;
+    int winner; // As GameState::winner; 0 if the recording was cut short
+};
+
+class ReplayRecorder
+{
+    public:
+        void Begin(uint64_t seed, int cellCount, double tickInterval);
+        void RecordTick(Cell direction1, Cell direction2);
+        std::vector<uint8_t> Finish(int winner);
+        
+        bool IsRecording() const { return recording; }
+        
+        static int DirectionCode(Cell direction);
+        static Cell CodeDirection(int code);
+        
+    private:
+        void FlushRun();
+        
+        ReplayHeader header{};
+        std::vector<uint8_t> runs;
+        int runDirections = 0;
+        uint64_t runLength = 0;
+        bool recording = false;
+};
+
+// Reads a replay in place (no copy), e.g. straight out of a mapped file
+class ReplayReader
+{
+    public:
+        ReplayReader(const uint8_t* data, size_t size);
+        
+        bool IsValid() const { return valid; }
+        const ReplayHeader& Header() const { return header; }
+        
+        // Directions for the next tick; false once every tick has been read
+        bool NextTick(Cell& direction1, Cell& direction2);
+        
+    private:
+        const uint8_t* cursor;
+        const uint8_t* end;
+        ReplayHeader header{};
+        int runDirections = 0;
+        uint64_t runRemaining = 0;
+        int ticksRead = 0;
+        bool valid = false;
+};
+
@@ -0,0 +1,29 @@
+#pragma once
+#include "MappedFile.hpp"
+#include "Replay.hpp"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Memory-mapped replay log (as written by ReplayWriter). Opening only scans
+// the record length prefixes; replays are decoded straight from the mapping.
+class ReplayLog
+{
+    public:
+        static constexpr const char* defaultPath = "replays.snkr"; // Where the game appends its rounds
+        
+        explicit ReplayLog(const std::string& path);
+        
+        int Count() const { return static_cast<int>(records.size()); }
+        ReplayReader Open(int index) const;
+        
+    private:
+        struct Record
+        {
+            size_t offset;
+            size_t size;
+        };
+        
+        MappedFile file;
+        std::vector<Record> records;
+};
@@ -0,0 +1,34 @@
+#pragma once
+#include "GameState.hpp"
+#include "Replay.hpp"
+#include <cstdint>
+#include <vector>
+
+// Random-access playback of one replay. Loading simulates the match once and
+// keeps a full GameState keyframe every keyframeInterval ticks, so Seek()
+// only resimulates from the nearest keyframe (at most keyframeInterval - 1
+// ticks) no matter how long the match is.
+class ReplayPlayer
+{
+    public:
+        static const int keyframeInterval = 64;
+        
+        explicit ReplayPlayer(ReplayReader reader);
+        
+        const ReplayHeader& Header() const { return header; }
+        int TickCount() const { return static_cast<int>(moves.size()); }
+        int CurrentTick() const { return tick; }
+        const GameState& State() const { return state; }
+        
+        void Seek(int targetTick);
+        void StepForward();
+        
+    private:
+        void ApplyMove(int moveTick);
+        
+        ReplayHeader header;
+        std::vector<uint8_t> moves;        // Direction codes, one byte per tick
+        std::vector<GameSnapshot> keyframes; // State before tick i * keyframeInterval
+        GameState state;
+        int tick;
+};
@@ -0,0 +1,37 @@
+#pragma once
+#include "Scene.hpp"
+#include "Game.hpp"
+#include "Global.hpp"
+#include "ReplayLog.hpp"
+#include "ReplayPlayer.hpp"
+#include "SimClock.hpp"
+#include <memory>
+
+// Plays back rounds from the replay log with pause, step and seek
+class ReplayScene : public Scene
+{
+    public:
+        ReplayScene();
+        ~ReplayScene() override = default;
+        
+        void OnLoad() override;
+        void Update() override;
+        void Draw() const override;
+        void OnUnload() override;
+        
+    private:
+        std::unique_ptr<Game> game;   // Silent, only used to draw the replayed state
+        std::unique_ptr<Global> global;
+        std::unique_ptr<ReplayLog> log;
+        std::unique_ptr<ReplayPlayer> player;
+        SimClock clock;
+        
+        int selectedReplay;
+        bool paused;
+        
+        void OpenReplay(int index);
+        void SeekTo(int tick);
+        int LastTick() const;
+        void DrawUI() const;
+        void DrawEmptyScreen() const;
+};
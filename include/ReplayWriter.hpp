@@ -0,0 +1,33 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Appends finished replays to a replay log on a background thread so the
+// game loop never waits on disk. Each record is a varint byte length followed
+// by the replay bytes.
+class ReplayWriter
+{
+    public:
+        explicit ReplayWriter(const std::string& path);
+        ~ReplayWriter(); // Writes everything still queued
+        
+        ReplayWriter(const ReplayWriter&) = delete;
+        ReplayWriter& operator=(const ReplayWriter&) = delete;
+        
+        void Submit(std::vector<uint8_t> replay);
+        
+    private:
+        void WriterLoop();
+        
+        std::string path;
+        std::mutex queueMutex;
+        std::condition_variable queueChanged;
+        std::deque<std::vector<uint8_t>> queue;
+        bool stopping = false;
+        std::thread writer;
+};
@@ -0,0 +1,27 @@
+#pragma once
+#include <functional>
+
+// Fixed-timestep simulation clock owned by a single game.
+// Accumulates elapsed time from an injectable time source and reports how
+// many ticks are due, running several per call when behind (up to
+// maxCatchUpTicks) instead of dropping them.
+class SimClock
+{
+    public:
+        using TimeSource = std::function<double()>;
+        
+        SimClock(double interval, TimeSource timeSource = SteadyTime);
+        
+        int Advance();   // Number of ticks due since the previous call
+        void Restart();  // Drop accumulated time, e.g. when play (re)starts
+        
+        static double SteadyTime(); // Seconds from std::chrono::steady_clock
+        
+        double interval;
+        int maxCatchUpTicks;
+        
+    private:
+        TimeSource timeSource;
+        double lastTime;
+        double accumulator;
+};
@@ -1,24 +1,41 @@
 #pragma once
-#include "raylib.h"
-#include <deque>
+#include "Bitboard.hpp"
+#include "Cell.hpp"
+#include "SnakeBody.hpp"
+#include "Zobrist.hpp"
+#include <cstdint>
 
 class Snake
 {
     public:
         Snake();
-        Snake(Vector2 startPos, Vector2 startDirection);
+        Snake(Cell startPos, Cell startDirection);
         
-        void Draw(int cellSize, int borderSize, Color snakeColor) const;
         void Update();
-        void Reset(Music& music);
-        void ResetWithPosition(Music& music, Vector2 startPos, Vector2 startDirection);
-        Vector2 GetAIDirection(Vector2 foodPos, const Snake& opponent) const;
+        void Reset();
+        void ResetWithPosition(Cell startPos, Cell startDirection);
+        Cell GetAIDirection(Cell foodPos, const Snake& opponent) const;
+        void Steer(Cell newDirection);
+        bool Occupies(Cell cell) const { return occupancy.Test(cell); }
+        const Bitboard& Occupancy() const { return occupancy; }
         
-        std::deque<Vector2> body;
-        Vector2 direction;
+        // Zobrist key of this snake (occupied cells, head, tail, direction
+        // and pending growth). Kept up to date by Update, so this is O(1).
+        uint64_t Hash() const
+        {
+            return hash ^ Zobrist::Direction(direction) ^ (addSegment ? Zobrist::Growing() : 0);
+        }
+        
+        SnakeBody body;
+        Cell direction;
         bool addSegment;
+        bool hitSelf; // head moved onto its own body during the last Update
         
     private:
-        Vector2 initialPosition;
-        Vector2 initialDirection;
-};
\ No newline at end of file
+        void PlaceAt(Cell startPos, Cell startDirection);
+        
+        Bitboard occupancy; // cells covered by body, kept in sync on push/pop
+        uint64_t hash;      // Zobrist key of occupancy, head and tail
+        Cell initialPosition;
+        Cell initialDirection;
+};
@@ -0,0 +1,71 @@
+#pragma once
+#include "Bitboard.hpp"
+#include "Cell.hpp"
+#include <cstdint>
+
+// Fixed-capacity ring buffer of snake segments, head first.
+// Cells are packed into 16 bits (signed 8-bit x and y, so a head that has
+// just left the board is still representable). Never allocates.
+class SnakeBody
+{
+    public:
+        static const int capacity = Bitboard::cellTotal;
+        
+        class Iterator
+        {
+            public:
+                Iterator(const SnakeBody* body, int offset) : body(body), offset(offset) {}
+                
+                Cell operator*() const { return (*body)[offset]; }
+                Iterator& operator++() { offset++; return *this; }
+                bool operator!=(const Iterator& other) const { return offset != other.offset; }
+                
+            private:
+                const SnakeBody* body;
+                int offset;
+        };
+        
+        SnakeBody() : head(0), length(0) {}
+        
+        int size() const { return length; }
+        void clear() { head = 0; length = 0; }
+        
+        Cell operator[](int i) const { return Unpack(cells[Wrap(head + i)]); }
+        Cell front() const { return Unpack(cells[head]); }
+        Cell back() const { return (*this)[length - 1]; }
+        
+        void push_front(Cell cell)
+        {
+            head = (head == 0) ? capacity - 1 : head - 1;
+            cells[head] = Pack(cell);
+            length++;
+        }
+        
+        void push_back(Cell cell)
+        {
+            cells[Wrap(head + length)] = Pack(cell);
+            length++;
+        }
+        
+        void pop_back() { length--; }
+        
+        Iterator begin() const { return Iterator(this, 0); }
+        Iterator end() const { return Iterator(this, length); }
+        
+    private:
+        static int Wrap(int index) { return index >= capacity ? index - capacity : index; }
+        
+        static uint16_t Pack(Cell cell)
+        {
+            return static_cast<uint16_t>(static_cast<uint8_t>(cell.x) | (static_cast<uint8_t>(cell.y) << 8));
+        }
+        
+        static Cell Unpack(uint16_t packed)
+        {
+            return Cell{static_cast<int8_t>(packed & 0xFF), static_cast<int8_t>(packed >> 8)};
+        }
+        
+        uint16_t cells[capacity];
+        int head;
+        int length;
+};
@@ -0,0 +1,52 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing thread pool. Each worker owns a task queue: it pops its own
+// newest task first and, when empty, steals the oldest task from another
+// worker. Tasks submitted from outside are spread round-robin.
+class ThreadPool
+{
+    public:
+        using Task = std::function<void()>;
+        
+        explicit ThreadPool(int threadCount = 0); // 0 = one per hardware thread
+        ~ThreadPool();
+        
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+        
+        void Submit(Task task);
+        void Wait(); // Blocks until every submitted task has finished
+        
+        int ThreadCount() const { return static_cast<int>(workers.size()); }
+        
+    private:
+        struct WorkerQueue
+        {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+        
+        void WorkerLoop(int index);
+        bool TryPopOwn(int index, Task& task);
+        bool TrySteal(int index, Task& task);
+        
+        std::vector<std::unique_ptr<WorkerQueue>> queues;
+        std::vector<std::thread> workers;
+        
+        std::mutex stateMutex;
+        std::condition_variable workAvailable;
+        std::condition_variable allDone;
+        int queuedTasks = 0;   // Submitted but not yet picked up
+        int pendingTasks = 0;  // Submitted but not yet finished
+        bool stopping = false;
+        
+        std::atomic<unsigned int> nextQueue{0};
+};
@@ -0,0 +1,51 @@
+#pragma once
+#include "Cell.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Result of searching one position, as cached in the transposition table
+struct TranspositionEntry
+{
+    static const int boundExact = 0;
+    static const int boundLower = 1; // Score is at least this (beta cutoff)
+    static const int boundUpper = 2; // Score is at most this (failed low)
+    
+    int score;
+    int depth;
+    int bound;
+    Cell bestMove; // {0, 0} if none
+};
+
+// Fixed-size transposition table keyed by GameState::Hash(), safe to share
+// between search threads without locks. Each slot is two relaxed atomics and
+// stores key ^ data next to data, so a slot torn by a concurrent write fails
+// the key check on Probe instead of returning another position's result.
+class TranspositionTable
+{
+    public:
+        explicit TranspositionTable(int sizeLog2 = 20); // 2^sizeLog2 slots, 16 bytes each
+        
+        TranspositionTable(const TranspositionTable&) = delete;
+        TranspositionTable& operator=(const TranspositionTable&) = delete;
+        
+        bool Probe(uint64_t key, TranspositionEntry& entry) const;
+        void Store(uint64_t key, const TranspositionEntry& entry);
+        void Clear(); // Not safe while other threads are searching
+        
+        size_t SlotCount() const { return mask + 1; }
+        
+    private:
+        struct Slot
+        {
+            std::atomic<uint64_t> check; // key ^ data
+            std::atomic<uint64_t> data;
+        };
+        
+        static uint64_t Pack(const TranspositionEntry& entry);
+        static TranspositionEntry Unpack(uint64_t data);
+        
+        std::unique_ptr<Slot[]> slots;
+        size_t mask;
+};
@@ -0,0 +1,26 @@
+#pragma once
+#include "AIWeights.hpp"
+#include "Cell.hpp"
+#include "FloodFill.hpp"
+#include "GameState.hpp"
+
+// One-ply heuristic AI whose trade-offs are AIWeights: each legal move is
+// scored on distance to the food, room behind it and closeness to the
+// opponent's head. Cheap enough (one flood fill load, four fills) to play
+// thousands of matches per weight set when tuning.
+class WeightedAI
+{
+    public:
+        static const int spaceCap = 60;    // Room beyond this counts the same
+        static const int nearOpponent = 3; // Head distance where the opponent starts to count
+        
+        explicit WeightedAI(const AIWeights& weights) : weights(weights) {}
+        
+        // {0, 0} if every move is fatal
+        Cell BestMove(const GameState& state, int player);
+        
+        AIWeights weights;
+        
+    private:
+        FloodFill floodFill;
+};
@@ -0,0 +1,79 @@
+#pragma once
+#include "Bitboard.hpp"
+#include "Cell.hpp"
+#include <cstdint>
+
+// Zobrist keys for hashing positions. A position's key is the XOR of the keys
+// of its features, so moving a snake one cell only XORs a handful of keys
+// in and out. The tables are generated at compile time (SplitMix64), so keys
+// are identical across runs and builds.
+class Zobrist
+{
+    public:
+        // Keys of a single snake's features. Player 2 uses the same keys
+        // rotated by 32 bits (see Opponent), which keeps the two snakes
+        // distinct without a second set of tables.
+        static uint64_t Body(Cell cell) { return Lookup(keys.body, cell); }
+        static uint64_t Head(Cell cell) { return Lookup(keys.head, cell); }
+        static uint64_t Tail(Cell cell) { return Lookup(keys.tail, cell); }
+        static uint64_t Direction(Cell direction) { return keys.direction[DirectionIndex(direction)]; }
+        static uint64_t Growing() { return keys.growing; }
+        
+        static uint64_t Food(Cell cell) { return Lookup(keys.food, cell); }
+        
+        static uint64_t Opponent(uint64_t snakeKey) { return (snakeKey << 32) | (snakeKey >> 32); }
+        
+    private:
+        struct Keys
+        {
+            uint64_t body[Bitboard::cellTotal];
+            uint64_t head[Bitboard::cellTotal];
+            uint64_t tail[Bitboard::cellTotal];
+            uint64_t food[Bitboard::cellTotal];
+            uint64_t direction[4];
+            uint64_t growing;
+        };
+        
+        static constexpr uint64_t SplitMix(uint64_t& state)
+        {
+            state += 0x9e3779b97f4a7c15ULL;
+            uint64_t z = state;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            return z ^ (z >> 31);
+        }
+        
+        static constexpr Keys MakeKeys()
+        {
+            Keys result{};
+            uint64_t state = 0x5eed5a4e0b1dULL;
+            
+            for (int i = 0; i < Bitboard::cellTotal; i++) result.body[i] = SplitMix(state);
+            for (int i = 0; i < Bitboard::cellTotal; i++) result.head[i] = SplitMix(state);
+            for (int i = 0; i < Bitboard::cellTotal; i++) result.tail[i] = SplitMix(state);
+            for (int i = 0; i < Bitboard::cellTotal; i++) result.food[i] = SplitMix(state);
+            for (int i = 0; i < 4; i++) result.direction[i] = SplitMix(state);
+            result.growing = SplitMix(state);
+            
+            return result;
+        }
+        
+        // Off-board cells (a head that just hit the wall) hash to nothing
+        static uint64_t Lookup(const uint64_t (&table)[Bitboard::cellTotal], Cell cell)
+        {
+            return Bitboard::InBounds(cell) ? table[Bitboard::Index(cell)] : 0;
+        }
+        
+        static int DirectionIndex(Cell direction)
+        {
+            if (direction.y < 0) return 0;
+            if (direction.y > 0) return 1;
+            if (direction.x < 0) return 2;
+            return 3;
+        }
+        
+        static const Keys keys;
+};
+
+// Constant-initialized: the tables are baked into the binary
+inline const Zobrist::Keys Zobrist::keys = Zobrist::MakeKeys();
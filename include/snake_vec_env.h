@@ -0,0 +1,61 @@
+#ifndef SNAKE_VEC_ENV_H
+#define SNAKE_VEC_ENV_H
+
+/*
+ * C ABI for training policies on the game rules (libsnakeenv.so).
+ *
+ * One environment is one two-snake game with the same rules as the game
+ * (GameState::Step). Every call works on all environments at once, spread
+ * over worker threads, and writes straight into the caller's buffers.
+ *
+ * Observations: for each environment and each snake (index 0 = player 1),
+ * SNAKE_VEC_ENV_PLANES bit-planes of the board from that snake's point of
+ * view, in this order: own body, opponent body, both heads, food. A plane is
+ * SNAKE_VEC_ENV_PLANE_WORDS little-endian 64-bit words; cell (x, y) is bit
+ * y * SNAKE_VEC_ENV_BOARD_SIZE + x. With NumPy:
+ *     np.unpackbits(obs.view(np.uint8), axis=-1, bitorder="little")[..., :625].reshape(..., 25, 25)
+ *
+ * Actions: one byte per snake, 0 = up, 1 = down, 2 = left, 3 = right; any
+ * other value (and reversing) keeps the current direction.
+ *
+ * Rewards (per snake): SNAKE_VEC_ENV_FOOD_REWARD per food eaten, and at the
+ * end of a round +1 for the winner, -1 for the loser, 0 on a tie or when
+ * the round is cut off after SNAKE_VEC_ENV_MAX_TICKS ticks. A finished
+ * environment sets its done flag and starts a new round with a fresh seed;
+ * the observation returned is the new round's first.
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SNAKE_VEC_ENV_BOARD_SIZE 25
+#define SNAKE_VEC_ENV_PLANES 4
+#define SNAKE_VEC_ENV_PLANE_WORDS 10
+#define SNAKE_VEC_ENV_AGENT_WORDS (SNAKE_VEC_ENV_PLANES * SNAKE_VEC_ENV_PLANE_WORDS)
+#define SNAKE_VEC_ENV_FOOD_REWARD 0.1f
+#define SNAKE_VEC_ENV_MAX_TICKS 5000
+
+typedef struct SnakeVecEnv SnakeVecEnv;
+
+/* num_envs games; environment i's rounds are seeded from seed + i. Returns NULL on failure. */
+SnakeVecEnv* snake_vec_env_create(int num_envs, uint64_t seed);
+void snake_vec_env_destroy(SnakeVecEnv* env);
+
+int snake_vec_env_num_envs(const SnakeVecEnv* env);
+
+/* Starts a new round everywhere. observations: num_envs * 2 * SNAKE_VEC_ENV_AGENT_WORDS words. */
+void snake_vec_env_reset(SnakeVecEnv* env, uint64_t* observations);
+
+/* One tick everywhere. actions: num_envs * 2 bytes; rewards: num_envs * 2;
+   dones: num_envs. Any output pointer may be NULL to skip it. */
+void snake_vec_env_step(SnakeVecEnv* env, const uint8_t* actions, uint64_t* observations,
+                        float* rewards, uint8_t* dones);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,90 @@
+#include "AIControllers.hpp"
+#include "HamiltonianCycle.hpp"
+#include "OpeningBook.hpp"
+
+using namespace std;
+
+namespace
+{
+    const Snake& Own(const GameState& state, int player)
+    {
+        return player == 1 ? state.player1 : state.player2;
+    }
+    
+    const Snake& Other(const GameState& state, int player)
+    {
+        return player == 1 ? state.player2 : state.player1;
+    }
+    
+    // Move from OpeningBook::active, if it has the position. The book only
+    // holds 0-0 positions and Hash() leaves the scores out, so once either
+    // snake has eaten it is not probed. A book move into a wall or a body
+    // (a book from older rules) is ignored and the position searched.
+    bool BookMove(const GameState& state, int player, Cell& move)
+    {
+        if (OpeningBook::active == nullptr || state.score != 0 || state.score2 != 0)
+            return false;
+        if (!OpeningBook::active->Probe(state.Hash(), player, move))
+            return false;
+        
+        Cell next = Own(state, player).body[0] + move;
+        return Bitboard::InBounds(next) && state.OwnerAt(next) == 0;
+    }
+    
+    // Seconds left until deadline, never negative
+    double Budget(IController::Clock::time_point deadline)
+    {
+        return max(0.0, chrono::duration<double>(deadline - IController::Clock::now()).count());
+    }
+}
+
+Cell GreedyController::Choose(const GameState& state, int player, Clock::time_point)
+{
+    return Own(state, player).GetAIDirection(state.food.position, Other(state, player));
+}
+
+Cell PathController::Choose(const GameState& state, int player, Clock::time_point)
+{
+    distanceField.Compute(state);
+    return distanceField.BestMove(Own(state, player));
+}
+
+Cell CycleController::Choose(const GameState& state, int player, Clock::time_point)
+{
+    return HamiltonianCycle::BestMove(Own(state, player), Other(state, player), state.food.position);
+}
+
+Cell SearchController::Choose(const GameState& state, int player, Clock::time_point deadline)
+{
+    Cell move;
+    if (BookMove(state, player, move))
+        return move;
+    
+    return search.Search(state, player, Budget(deadline)).move;
+}
+
+Cell MonteCarloController::Choose(const GameState& state, int player, Clock::time_point deadline)
+{
+    Cell move;
+    if (BookMove(state, player, move))
+        return move;
+    
+    return search.Search(state, player, Budget(deadline)).move;
+}
+
+Cell TunedController::Choose(const GameState& state, int player, Clock::time_point)
+{
+    return ai.BestMove(state, player);
+}
+
+Cell PolicyController::Choose(const GameState& state, int player, Clock::time_point)
+{
+    if (!network.IsLoaded())
+        return Own(state, player).GetAIDirection(state.food.position, Other(state, player));
+    
+    uint64_t observation[Observation::wordCount];
+    float logits[PolicyNetwork::outputCount];
+    Observation::Write(state, player, observation);
+    network.Evaluate(observation, 1, logits, scratch);
+    return PolicyNetwork::ChooseMove(logits, state, player);
+}
@@ -9,30 +9,33 @@ namespace
     constexpr int BORDER_PADDING = 5;
     constexpr int TITLE_FONT_SIZE = 40;
     constexpr int TITLE_Y_POSITION = 20;
+    constexpr int SEARCH_THREADS = 0; // One per hardware thread
 }
 
 AIGameScene::AIGameScene()
     : Scene("AIGame", 2),
+      keyboard(std::make_shared<KeyboardController>(KEY_W, KEY_S, KEY_A, KEY_D)),
+      playerDriver(1),
+      aiDriver(2),
       gameUpdateInterval(GAME_UPDATE_INTERVAL),
       waitingForPlayer(true),
       readyPulseTimer(0.0f),
-      playerNextDirection{0, 0},
-      playerDirectionChanged(false)
+      aiKind(IController::kindPath)
 {
+    playerDriver.SetController(keyboard);
+    aiDriver.SetController(IController::Create(aiKind, SEARCH_THREADS));
 }
 
 void AIGameScene::OnLoad()
 {
     game = std::make_unique<Game>();
+    game->clock.interval = gameUpdateInterval;
     global = std::make_unique<Global>();
     
     // Don't start the game immediately - wait for player
     game->running = false;
     waitingForPlayer = true;
     readyPulseTimer = 0.0f;
-    
-    playerNextDirection = {0, 0};
-    playerDirectionChanged = false;
 }
 
 void AIGameScene::Update()
@@ -66,23 +69,19 @@ void AIGameScene::Update()
         UpdateMusicStream(Global::easyAndNormalModeMusic);
     }
     
-    // Handle player input
-    HandlePlayerInput();
-    
-    // Update AI
-    UpdateAI();
+    // Player 1 - WASD, one turn buffered per tick
+    keyboard->Poll(game->player1);
     
-    // Update game logic at fixed interval
-    if (Global::EventTriggered(gameUpdateInterval))
+    // Run every fixed-interval tick that is due this frame
+    int ticksDue = game->clock.Advance();
+    for (int i = 0; i < ticksDue; i++)
     {
-        // Apply buffered direction change before updating
-        if (playerDirectionChanged)
-        {
-            game->player1.direction = playerNextDirection;
-            playerDirectionChanged = false;
-        }
-        
+        // The buffered turn and the AI move decided since the last tick,
+        // then the AI starts on the next one
+        playerDriver.Apply(*game);
+        aiDriver.Apply(*game);
         game->Update();
+        aiDriver.Request(*game, gameUpdateInterval);
     }
     
     // ESC to return to main menu
@@ -196,68 +195,16 @@ void AIGameScene::DrawUI() const
         TITLE_FONT_SIZE, 
         RED
     );
-}
-
-void AIGameScene::HandlePlayerInput()
-{
-    // Get the actual current direction from body position (head vs second segment)
-    Vector2 playerActualDirection = game->player1.direction;
-    
-    if (game->player1.body.size() >= 2)
-    {
-        Vector2 head = game->player1.body[0];
-        Vector2 neck = game->player1.body[1];
-        playerActualDirection = {head.x - neck.x, head.y - neck.y};
-    }
-    
-    // Player 1 - WASD controls only (only allow one direction change per update)
-    if (!playerDirectionChanged)
-    {
-        if (IsKeyPressed(KEY_W) && playerActualDirection.y != 1)
-        {
-            game->running = true;
-            playerNextDirection = {0, -1};
-            playerDirectionChanged = true;
-        }
-        else if (IsKeyPressed(KEY_S) && playerActualDirection.y != -1)
-        {
-            game->running = true;
-            playerNextDirection = {0, 1};
-            playerDirectionChanged = true;
-        }
-        else if (IsKeyPressed(KEY_A) && playerActualDirection.x != 1)
-        {
-            game->running = true;
-            playerNextDirection = {-1, 0};
-            playerDirectionChanged = true;
-        }
-        else if (IsKeyPressed(KEY_D) && playerActualDirection.x != -1)
-        {
-            game->running = true;
-            playerNextDirection = {1, 0};
-            playerDirectionChanged = true;
-        }
-    }
-}
-
-void AIGameScene::UpdateAI()
-{
-    if (!game->running) return;
     
-    // Get AI direction based on food position
-    Vector2 aiDirection = game->player2.GetAIDirection(game->food.position, game->player1);
-    
-    // Only update if it's a valid move (not reversing)
-    if (aiDirection.x != 0 || aiDirection.y != 0)
-    {
-        if ((aiDirection.y == -1 && game->player2.direction.y != 1) ||
-            (aiDirection.y == 1 && game->player2.direction.y != -1) ||
-            (aiDirection.x == -1 && game->player2.direction.x != 1) ||
-            (aiDirection.x == 1 && game->player2.direction.x != -1))
-        {
-            game->player2.direction = aiDirection;
-        }
-    }
+    // Which AI, and how long its last decision took
+    const IController* ai = aiDriver.Controller();
+    DrawText(
+        TextFormat("%s %.1f ms", ai->Name(), ai->Latency().last * 1000.0), 
+        Game::borderSize + 480, 
+        scoreY + 12, 
+        20, 
+        GRAY
+    );
 }
 
 void AIGameScene::OnUnload()
@@ -293,14 +240,23 @@ void AIGameScene::DrawReadyScreen() const
     );
     
     // AI indicator
+    const char* aiText = TextFormat("vs %s AI", aiDriver.Controller()->Name());
     DrawText(
-        "vs SMART AI",
+        aiText,
         screenWidth / 2 - 100,
         screenHeight / 2 + 50,
         30,
         RED
     );
     
+    DrawText(
+        "TAB to switch AI",
+        screenWidth / 2 - 100,
+        screenHeight / 2 + 90,
+        20,
+        GRAY
+    );
+    
     // Ready instruction (pulsing)
     const char* readyText = "PRESS ANY KEY TO START";
     int readyWidth = MeasureText(readyText, 28);
@@ -318,8 +274,14 @@ void AIGameScene::DrawReadyScreen() const
 
 void AIGameScene::CheckReadyInput()
 {
+    if (IsKeyPressed(KEY_TAB))
+    {
+        aiKind = (aiKind + 1) % IController::kindCount;
+        aiDriver.SetController(IController::Create(aiKind, SEARCH_THREADS));
+    }
+    
     // Detect player input
-    Vector2 playerDir = {0, 0};
+    Cell playerDir = {0, 0};
     
     if (IsKeyDown(KEY_W)) playerDir = {0, -1};
     else if (IsKeyDown(KEY_S)) playerDir = {0, 1};
@@ -330,6 +292,9 @@ void AIGameScene::CheckReadyInput()
     
     if (playerReady)
     {
+        // Fresh, recorded round
+        game->BeginRound();
+        
         // Set player initial direction
         game->player1.direction = playerDir;
         
@@ -339,5 +304,7 @@ void AIGameScene::CheckReadyInput()
         // Start the game
         game->running = true;
         waitingForPlayer = false;
+        keyboard->Clear();
+        aiDriver.Request(*game, gameUpdateInterval);
     }
 }
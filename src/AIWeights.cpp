@@ -0,0 +1,63 @@
+#include "AIWeights.hpp"
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+    const char* const NAMES[AIWeights::count] = {"food", "space", "trapped", "opponent"};
+}
+
+const char* AIWeights::Name(int i)
+{
+    return NAMES[i];
+}
+
+bool AIWeights::Load(const char* path)
+{
+    FILE* file = fopen(path, "r");
+    if (file == nullptr)
+        return false;
+    
+    AIWeights loaded = *this;
+    char name[32];
+    float value;
+    bool valid = true;
+    
+    while (valid)
+    {
+        int fields = fscanf(file, "%31s %f", name, &value);
+        if (fields == EOF)
+            break;
+        
+        valid = false;
+        for (int i = 0; i < count && fields == 2; i++)
+        {
+            if (strcmp(name, NAMES[i]) == 0)
+            {
+                loaded[i] = value;
+                valid = true;
+            }
+        }
+    }
+    
+    fclose(file);
+    if (valid)
+    {
+        *this = loaded;
+    }
+    return valid;
+}
+
+bool AIWeights::Save(const char* path) const
+{
+    FILE* file = fopen(path, "w");
+    if (file == nullptr)
+        return false;
+    
+    for (int i = 0; i < count; i++)
+    {
+        fprintf(file, "%s %.6g\n", NAMES[i], (*this)[i]);
+    }
+    
+    return fclose(file) == 0;
+}
@@ -10,21 +10,29 @@ namespace
     constexpr int TITLE_FONT_SIZE = 40;
     constexpr int TITLE_Y_POSITION = 20;
     constexpr float START_DELAY = 2.0f;
+    constexpr int SEARCH_THREADS = 0; // One per hardware thread
 }
 
 AIvsAIScene::AIvsAIScene()
     : Scene("AIvsAI", 3),
+      driver1(1),
+      driver2(2),
       gameUpdateInterval(GAME_UPDATE_INTERVAL),
       waitingToStart(true),
       startPulseTimer(0.0f),
       deathDelayTimer(0.0f),
-      inDeathDelay(false)
+      inDeathDelay(false),
+      ai1Kind(IController::kindPath),
+      ai2Kind(IController::kindPath)
 {
+    driver1.SetController(IController::Create(ai1Kind, SEARCH_THREADS));
+    driver2.SetController(IController::Create(ai2Kind, SEARCH_THREADS));
 }
 
 void AIvsAIScene::OnLoad()
 {
     game = std::make_unique<Game>();
+    game->clock.interval = gameUpdateInterval;
     global = std::make_unique<Global>();
     
     // Don't start the game immediately - show countdown
@@ -38,6 +46,7 @@ void AIvsAIScene::OnLoad()
 void AIvsAIScene::Update()
 {
     startPulseTimer += GetFrameTime();
+    HandleAISelection();
     
     // Handle death delay
     if (inDeathDelay)
@@ -57,11 +66,15 @@ void AIvsAIScene::Update()
             global.reset();
             
             game = std::make_unique<Game>();
+            game->clock.interval = gameUpdateInterval;
             global = std::make_unique<Global>();
             
+            game->BeginRound();
             game->running = true;
             game->player1.direction = {1, 0};
             game->player2.direction = {-1, 0};
+            driver1.Request(*game, gameUpdateInterval);
+            driver2.Request(*game, gameUpdateInterval);
             
             inDeathDelay = false;
             deathDelayTimer = 0.0f;
@@ -73,12 +86,16 @@ void AIvsAIScene::Update()
     // Auto-start after delay
     if (waitingToStart && startPulseTimer >= START_DELAY)
     {
+        game->BeginRound();
+        
         // Set initial directions for both AI
         game->player1.direction = {1, 0};  // Start moving right
         game->player2.direction = {-1, 0}; // Start moving left
         
         game->running = true;
         waitingToStart = false;
+        driver1.Request(*game, gameUpdateInterval);
+        driver2.Request(*game, gameUpdateInterval);
     }
     
     // If game stopped (someone died), start death delay
@@ -100,14 +117,16 @@ void AIvsAIScene::Update()
         UpdateMusicStream(Global::easyAndNormalModeMusic);
     }
     
-    // Update both AIs
-    UpdateAI1();
-    UpdateAI2();
-    
-    // Update game logic at fixed interval
-    if (Global::EventTriggered(gameUpdateInterval))
+    // Run every fixed-interval tick that is due this frame
+    int ticksDue = game->clock.Advance();
+    for (int i = 0; i < ticksDue; i++)
     {
+        // Moves decided since the last tick, then start on the next ones
+        driver1.Apply(*game);
+        driver2.Apply(*game);
         game->Update();
+        driver1.Request(*game, gameUpdateInterval);
+        driver2.Request(*game, gameUpdateInterval);
     }
     
     // ESC to return to main menu
@@ -229,45 +248,36 @@ void AIvsAIScene::DrawUI() const
         TITLE_FONT_SIZE, 
         RED
     );
-}
-
-void AIvsAIScene::UpdateAI1()
-{
-    if (!game->running) return;
     
-    // Get AI direction based on food position
-    Vector2 aiDirection = game->player1.GetAIDirection(game->food.position, game->player2);
+    DrawText(
+        TextFormat("%s %.1f ms", driver1.Controller()->Name(), driver1.Controller()->Latency().last * 1000.0), 
+        Game::borderSize + 200, 
+        scoreY + 12, 
+        20, 
+        GRAY
+    );
     
-    // Only update if it's a valid move (not reversing)
-    if (aiDirection.x != 0 || aiDirection.y != 0)
-    {
-        if ((aiDirection.y == -1 && game->player1.direction.y != 1) ||
-            (aiDirection.y == 1 && game->player1.direction.y != -1) ||
-            (aiDirection.x == -1 && game->player1.direction.x != 1) ||
-            (aiDirection.x == 1 && game->player1.direction.x != -1))
-        {
-            game->player1.direction = aiDirection;
-        }
-    }
+    DrawText(
+        TextFormat("%s %.1f ms", driver2.Controller()->Name(), driver2.Controller()->Latency().last * 1000.0), 
+        Game::borderSize + 520, 
+        scoreY + 12, 
+        20, 
+        GRAY
+    );
 }
 
-void AIvsAIScene::UpdateAI2()
+void AIvsAIScene::HandleAISelection()
 {
-    if (!game->running) return;
-    
-    // Get AI direction based on food position
-    Vector2 aiDirection = game->player2.GetAIDirection(game->food.position, game->player1);
+    if (IsKeyPressed(KEY_ONE))
+    {
+        ai1Kind = (ai1Kind + 1) % IController::kindCount;
+        driver1.SetController(IController::Create(ai1Kind, SEARCH_THREADS));
+    }
     
-    // Only update if it's a valid move (not reversing)
-    if (aiDirection.x != 0 || aiDirection.y != 0)
+    if (IsKeyPressed(KEY_TWO))
     {
-        if ((aiDirection.y == -1 && game->player2.direction.y != 1) ||
-            (aiDirection.y == 1 && game->player2.direction.y != -1) ||
-            (aiDirection.x == -1 && game->player2.direction.x != 1) ||
-            (aiDirection.x == 1 && game->player2.direction.x != -1))
-        {
-            game->player2.direction = aiDirection;
-        }
+        ai2Kind = (ai2Kind + 1) % IController::kindCount;
+        driver2.SetController(IController::Create(ai2Kind, SEARCH_THREADS));
     }
 }
 
@@ -333,6 +343,31 @@ void AIvsAIScene::DrawStartScreen() const
         startColor
     );
     
+    // AI selection
+    DrawText(
+        driver1.Controller()->Name(),
+        screenWidth / 2 - 200,
+        screenHeight / 2 + 40,
+        20,
+        GRAY
+    );
+    
+    DrawText(
+        driver2.Controller()->Name(),
+        screenWidth / 2 + 50,
+        screenHeight / 2 + 40,
+        20,
+        GRAY
+    );
+    
+    DrawText(
+        "Press 1 / 2 to switch each AI",
+        screenWidth / 2 - 150,
+        screenHeight - 120,
+        20,
+        GRAY
+    );
+    
     // ESC hint
     DrawText(
         "Press ESC to return to menu",
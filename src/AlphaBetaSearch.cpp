@@ -0,0 +1,358 @@
+#include "AlphaBetaSearch.hpp"
+#include "FloodFill.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <thread>
+
+using namespace std;
+
+namespace
+{
+    // Evaluation weights, in points
+    constexpr int SCORE_WEIGHT = 400;    // Per food eaten ahead of the opponent
+    constexpr int ROOM_WEIGHT = 4;       // Per reachable cell, up to ROOM_CAP
+    constexpr int ROOM_CAP = 100;
+    constexpr int TRAPPED_PENALTY = 20000; // Less room than body length
+    constexpr int FOOD_WEIGHT = 10;      // Per step closer to the food than the opponent
+    
+    constexpr uint64_t PLAYER_TWO_KEY = 0x9d2c5680a1f3e7b5ULL;
+    constexpr uint64_t SCORE_KEY = 0xc2b2ae3d27d4eb4fULL; // Odd, so every score lead maps to its own key
+    
+    constexpr int CHECK_CLOCK_EVERY = 256; // Nodes between deadline checks
+    
+    // Scores this close to winScore are wins or losses, not evaluations
+    constexpr int DECIDED_SCORE = AlphaBetaSearch::winScore - AlphaBetaSearch::maxDepth;
+    
+    int Distance(Cell a, Cell b)
+    {
+        return abs(a.x - b.x) + abs(a.y - b.y);
+    }
+    
+    // Win and loss scores count plies from the root. The table keeps them
+    // counted from the stored position instead, so an entry reached at
+    // another ply, or on a later tick, still gives the right distance.
+    int ScoreToTable(int score, int ply)
+    {
+        if (score >= DECIDED_SCORE)
+            return score + ply;
+        if (score <= -DECIDED_SCORE)
+            return score - ply;
+        return score;
+    }
+    
+    int ScoreFromTable(int score, int ply)
+    {
+        if (score >= DECIDED_SCORE)
+            return score - ply;
+        if (score <= -DECIDED_SCORE)
+            return score + ply;
+        return score;
+    }
+}
+
+// One search thread: its own scratch space and node count, sharing the
+// table, stop flag and deadline of the owning AlphaBetaSearch
+class AlphaBetaSearch::Worker
+{
+    public:
+        Worker(AlphaBetaSearch& owner, int index) : owner(owner), index(index) {}
+        
+        SearchResult Run(const GameState& state, int searchPlayer);
+        
+    private:
+        int SearchMine(const GameState& state, int depth, int ply, int alpha, int beta, Cell& bestMove);
+        int SearchTheirs(const GameState& state, Cell myMove, int depth, int ply, int alpha, int beta);
+        int Evaluate(const GameState& state);
+        int LargestRoom(const Snake& snake) const;
+        int OrderMoves(const GameState& state, const Snake& snake, Cell first, Cell moves[4]) const;
+        bool OutOfTime();
+        
+        const Snake& Mine(const GameState& state) const { return player == 1 ? state.player1 : state.player2; }
+        const Snake& Theirs(const GameState& state) const { return player == 1 ? state.player2 : state.player1; }
+        
+        AlphaBetaSearch& owner;
+        int index;
+        FloodFill floodFill;
+        int player = 1;
+        int64_t nodes = 0;
+};
+
+AlphaBetaSearch::AlphaBetaSearch(int threadCount, int tableSizeLog2)
+    : table(tableSizeLog2),
+      stop(false)
+{
+    if (threadCount <= 0)
+    {
+        threadCount = max(1u, thread::hardware_concurrency());
+    }
+    
+    for (int i = 0; i < threadCount; i++)
+    {
+        workers.push_back(make_unique<Worker>(*this, i));
+    }
+    
+    if (threadCount > 1)
+    {
+        helpers = make_unique<ThreadPool>(threadCount - 1);
+    }
+}
+
+AlphaBetaSearch::~AlphaBetaSearch() = default;
+
+SearchResult AlphaBetaSearch::Search(const GameState& state, int player, double timeBudget)
+{
+    deadline = Clock::now() + chrono::duration_cast<Clock::duration>(chrono::duration<double>(timeBudget));
+    stop.store(false, memory_order_relaxed);
+    
+    vector<SearchResult> results(workers.size());
+    
+    for (size_t i = 1; i < workers.size(); i++)
+    {
+        helpers->Submit([this, &state, &results, player, i] {
+            results[i] = workers[i]->Run(state, player);
+        });
+    }
+    
+    // The calling thread searches too; once it is done the helpers stop
+    results[0] = workers[0]->Run(state, player);
+    stop.store(true, memory_order_relaxed);
+    
+    if (helpers)
+    {
+        helpers->Wait();
+    }
+    
+    // Deepest finished search wins; on a tie, the main thread's
+    SearchResult best = results[0];
+    int64_t nodes = 0;
+    for (const SearchResult& result : results)
+    {
+        nodes += result.nodes;
+        if (result.depth > best.depth)
+        {
+            best = result;
+        }
+    }
+    
+    best.nodes = nodes;
+    return best;
+}
+
+SearchResult AlphaBetaSearch::Worker::Run(const GameState& state, int searchPlayer)
+{
+    player = searchPlayer;
+    nodes = 0;
+    
+    SearchResult result{Mine(state).direction, 0, 0, 0};
+    
+    // Odd helpers start one ply deeper so the threads spread over depths
+    for (int depth = 1 + (index & 1); depth <= maxDepth; depth++)
+    {
+        Cell move = {0, 0};
+        int score = SearchMine(state, depth, 0, -winScore - 1, winScore + 1, move);
+        
+        // An unfinished iteration may have missed the refutation: discard it
+        if (owner.stop.load(memory_order_relaxed))
+            break;
+        
+        result.move = move;
+        result.depth = depth;
+        result.score = score;
+        
+        // Forced win or loss found: looking deeper cannot change it
+        if (abs(score) >= DECIDED_SCORE)
+            break;
+    }
+    
+    result.nodes = nodes;
+    return result;
+}
+
+int AlphaBetaSearch::Worker::SearchMine(const GameState& state, int depth, int ply, int alpha, int beta, Cell& bestMove)
+{
+    // Scores are relative to the searching snake, so keep the two sides'
+    // entries apart; entries from earlier ticks stay useful. Hash() leaves
+    // out the scores, but Evaluate and score-decided endings depend on the
+    // lead, and the start positions repeat every round with other scores.
+    uint64_t lead = static_cast<uint64_t>(static_cast<int64_t>(state.score - state.score2));
+    uint64_t key = state.Hash() ^ (player == 2 ? PLAYER_TWO_KEY : 0) ^ (lead * SCORE_KEY);
+    int originalAlpha = alpha;
+    
+    TranspositionEntry entry;
+    Cell hashMove = {0, 0};
+    if (owner.table.Probe(key, entry))
+    {
+        hashMove = entry.bestMove;
+        
+        if (entry.depth >= depth && ply > 0)
+        {
+            int score = ScoreFromTable(entry.score, ply);
+            if (entry.bound == TranspositionEntry::boundExact)
+                return score;
+            if (entry.bound == TranspositionEntry::boundLower)
+                alpha = max(alpha, score);
+            else
+                beta = min(beta, score);
+            
+            if (alpha >= beta)
+                return score;
+        }
+    }
+    
+    Cell moves[4];
+    int moveCount = OrderMoves(state, Mine(state), hashMove, moves);
+    
+    int best = -winScore - 1;
+    bestMove = moves[0];
+    
+    for (int i = 0; i < moveCount; i++)
+    {
+        int value = SearchTheirs(state, moves[i], depth, ply, alpha, beta);
+        if (owner.stop.load(memory_order_relaxed))
+            return 0;
+        
+        if (value > best)
+        {
+            best = value;
+            bestMove = moves[i];
+        }
+        
+        alpha = max(alpha, value);
+        if (alpha >= beta)
+            break;
+    }
+    
+    int bound = best <= originalAlpha ? TranspositionEntry::boundUpper
+              : best >= beta ? TranspositionEntry::boundLower
+              : TranspositionEntry::boundExact;
+    owner.table.Store(key, TranspositionEntry{ScoreToTable(best, ply), depth, bound, bestMove});
+    
+    return best;
+}
+
+int AlphaBetaSearch::Worker::SearchTheirs(const GameState& state, Cell myMove, int depth, int ply, int alpha, int beta)
+{
+    Cell moves[4];
+    int moveCount = OrderMoves(state, Theirs(state), Cell{0, 0}, moves);
+    
+    int best = winScore + 1;
+    
+    for (int i = 0; i < moveCount; i++)
+    {
+        if (++nodes % CHECK_CLOCK_EVERY == 0 && OutOfTime())
+            return 0;
+        
+        GameState child = state;
+        (player == 1 ? child.player1 : child.player2).direction = myMove;
+        (player == 1 ? child.player2 : child.player1).direction = moves[i];
+        TickEvents events = child.Step();
+        
+        int value;
+        if (events.gameOver)
+        {
+            // Quicker wins and slower losses score better
+            if (child.winner == player)
+                value = winScore - ply;
+            else if (child.winner == 3)
+                value = 0;
+            else
+                value = -winScore + ply;
+        }
+        else if (depth <= 1)
+        {
+            value = Evaluate(child);
+        }
+        else
+        {
+            Cell reply;
+            value = SearchMine(child, depth - 1, ply + 1, alpha, beta, reply);
+            if (owner.stop.load(memory_order_relaxed))
+                return 0;
+        }
+        
+        best = min(best, value);
+        beta = min(beta, value);
+        if (alpha >= beta)
+            break;
+    }
+    
+    return best;
+}
+
+int AlphaBetaSearch::Worker::Evaluate(const GameState& state)
+{
+    const Snake& mine = Mine(state);
+    const Snake& theirs = Theirs(state);
+    
+    floodFill.Load(state);
+    int myRoom = LargestRoom(mine);
+    int theirRoom = LargestRoom(theirs);
+    
+    int myScore = player == 1 ? state.score : state.score2;
+    int theirScore = player == 1 ? state.score2 : state.score;
+    
+    int value = (myScore - theirScore) * SCORE_WEIGHT;
+    value += (min(myRoom, ROOM_CAP) - min(theirRoom, ROOM_CAP)) * ROOM_WEIGHT;
+    value += (Distance(theirs.body[0], state.food.position) - Distance(mine.body[0], state.food.position)) * FOOD_WEIGHT;
+    
+    if (myRoom < mine.body.size())
+        value -= TRAPPED_PENALTY;
+    if (theirRoom < theirs.body.size())
+        value += TRAPPED_PENALTY;
+    
+    return value;
+}
+
+int AlphaBetaSearch::Worker::LargestRoom(const Snake& snake) const
+{
+    Cell head = snake.body[0];
+    int largest = 0;
+    
+    for (const auto& dir : DIRECTIONS)
+    {
+        if (dir.x == -snake.direction.x && dir.y == -snake.direction.y)
+            continue;
+        
+        largest = max(largest, floodFill.Fill(head + dir).area);
+    }
+    
+    return largest;
+}
+
+int AlphaBetaSearch::Worker::OrderMoves(const GameState& state, const Snake& snake, Cell first, Cell moves[4]) const
+{
+    Cell head = snake.body[0];
+    int count = 0;
+    
+    for (const auto& dir : DIRECTIONS)
+    {
+        // Reversing is not a move: Steer ignores it
+        if (dir.x == -snake.direction.x && dir.y == -snake.direction.y)
+            continue;
+        moves[count++] = dir;
+    }
+    
+    // Best move from the table first, then towards the food; moves into
+    // walls or bodies last
+    auto priority = [&](Cell dir)
+    {
+        if (dir == first)
+            return -1;
+        
+        Cell next = head + dir;
+        bool fatal = !Bitboard::InBounds(next) || state.player1.Occupies(next) || state.player2.Occupies(next);
+        return (fatal ? 1000 : 0) + Distance(next, state.food.position);
+    };
+    
+    stable_sort(moves, moves + count, [&](Cell a, Cell b) { return priority(a) < priority(b); });
+    return count;
+}
+
+bool AlphaBetaSearch::Worker::OutOfTime()
+{
+    if (Clock::now() >= owner.deadline)
+    {
+        owner.stop.store(true, memory_order_relaxed);
+    }
+    return owner.stop.load(memory_order_relaxed);
+}
@@ -0,0 +1,678 @@
+#include "AlphaBetaSearch.hpp"
+#include "DistanceField.hpp"
+#include "IController.hpp"
+#include "Match.hpp"
+#include "MonteCarloSearch.hpp"
+#include "Observation.hpp"
+#include "OpeningBook.hpp"
+#include "PolicyNetwork.hpp"
+#include "Random.hpp"
+#include "ReplayWriter.hpp"
+#include "ThreadPool.hpp"
+#include "snake_vec_env.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// snake-batch: plays many headless AI vs AI matches on every core and
+// reports throughput and win rates.
+//
+// Usage: snake-batch [games] [threads] [seed] [scalar|search|mcts|league|env|snapshot|policy] [replay-log]
+//
+// "scalar" (the default) plays one match after another and can append
+// every match to a replay log.
+// "search" instead benchmarks the alpha-beta AI: games is the number of
+// positions searched, threads the largest thread count tried. "mcts" does the
+// same for the Monte Carlo tree search AI and reports playouts/sec. "league"
+// plays every AI controller against every other, games matches per pairing,
+// and reports each one's results and decision latency. "env" steps the C
+// vector environment (snake_vec_env.h) with random actions, games steps in
+// all, and reports environment steps/sec. "snapshot" times saving,
+// restoring and stepping copies of mid-game positions, games operations
+// each, in nanoseconds. "policy" plays the policy network against itself,
+// evaluating every snake of a task's games as one batch per tick, and
+// reports inferences/sec; the fifth argument is then the weights file
+// (random weights if it can't be loaded).
+
+namespace
+{
+    constexpr const char* USAGE =
+        "Usage: snake-batch [games] [threads] [seed] [scalar|search|mcts|league|env|snapshot|policy] [replay-log]\n";
+    constexpr long DEFAULT_GAMES = 100000;
+    constexpr uint64_t DEFAULT_SEED = 1;
+    constexpr int MAX_TICKS_PER_MATCH = 20000;
+    constexpr long GAMES_PER_TASK = 256;
+    constexpr double SEARCH_BUDGET = 0.05; // Seconds per searched position
+    constexpr int MIN_OPENING_TICKS = 20;  // Benchmark positions are this far into a game...
+    constexpr int OPENING_TICKS_SPREAD = 100; // ...plus up to this many more ticks
+    constexpr double LEAGUE_BUDGET = 0.002; // Seconds per decision in league matches
+    constexpr long LEAGUE_GAMES_PER_TASK = 4;
+    constexpr int ENV_BENCH_ENVS = 4096; // Environments in the vector environment benchmark
+    constexpr int ENV_ACTION_SETS = 16;  // Pre-drawn random action batches, used in turn
+    constexpr long POLICY_GAMES_PER_TASK = 256; // Games whose snakes share one network batch
+    constexpr int POLICY_HIDDEN_WIDTH = 64; // Random benchmark network: 2500-64-32-4
+    constexpr long SNAPSHOT_POSITIONS = 64; // Positions the snapshot benchmark cycles through (stay in cache)
+    
+    struct BatchStats
+    {
+        long games = 0;
+        long wins1 = 0;
+        long wins2 = 0;
+        long ties = 0;
+        long timeouts = 0;
+        long ticks = 0;
+        long score1 = 0;
+        long score2 = 0;
+        
+        void Add(const MatchResult& result)
+        {
+            games++;
+            ticks += result.ticks;
+            score1 += result.score1;
+            score2 += result.score2;
+            
+            switch (result.winner)
+            {
+                case 1: wins1++; break;
+                case 2: wins2++; break;
+                case 3: ties++; break;
+                default: timeouts++; break;
+            }
+        }
+        
+        void Merge(const BatchStats& other)
+        {
+            games += other.games;
+            wins1 += other.wins1;
+            wins2 += other.wins2;
+            ties += other.ties;
+            timeouts += other.timeouts;
+            ticks += other.ticks;
+            score1 += other.score1;
+            score2 += other.score2;
+        }
+    };
+    
+    // Mid-game positions from shortest-path AI vs shortest-path AI matches
+    vector<GameState> MakeSearchPositions(uint64_t seed, long count)
+    {
+        vector<GameState> positions;
+        DistanceField distanceField;
+        
+        for (uint64_t matchSeed = seed; static_cast<long>(positions.size()) < count; matchSeed++)
+        {
+            GameState game(matchSeed);
+            game.player1.direction = {1, 0};
+            game.player2.direction = {-1, 0};
+            
+            int ticks = MIN_OPENING_TICKS + static_cast<int>(matchSeed % OPENING_TICKS_SPREAD);
+            bool over = false;
+            for (int tick = 0; tick < ticks && !over; tick++)
+            {
+                distanceField.Compute(game);
+                game.player1.Steer(distanceField.BestMove(game.player1));
+                game.player2.Steer(distanceField.BestMove(game.player2));
+                over = game.Step().gameOver;
+            }
+            
+            // A finished round has already reset the board: not mid-game
+            if (!over)
+            {
+                positions.push_back(game);
+            }
+        }
+        return positions;
+    }
+    
+    // Searches every position for both snakes at 1, 2, 4, ... threads and
+    // reports how nodes/sec scales with the thread count
+    void RunSearchBenchmark(long count, int maxThreads, uint64_t seed)
+    {
+        if (maxThreads <= 0)
+        {
+            maxThreads = max(1u, thread::hardware_concurrency());
+        }
+        
+        vector<GameState> positions = MakeSearchPositions(seed, count);
+        
+        vector<int> threadCounts;
+        for (int threads = 1; threads < maxThreads; threads *= 2)
+        {
+            threadCounts.push_back(threads);
+        }
+        threadCounts.push_back(maxThreads);
+        
+        printf("search:       %zu positions x 2 players, %.0f ms each\n", positions.size(), SEARCH_BUDGET * 1000);
+        printf("threads   nodes/sec   speedup   per thread   avg depth\n");
+        
+        double baseline = 0.0;
+        for (int threads : threadCounts)
+        {
+            AlphaBetaSearch search(threads);
+            int64_t nodes = 0;
+            long depthTotal = 0;
+            long searches = 0;
+            
+            auto start = chrono::steady_clock::now();
+            for (const GameState& position : positions)
+            {
+                for (int player = 1; player <= 2; player++)
+                {
+                    SearchResult result = search.Search(position, player, SEARCH_BUDGET);
+                    nodes += result.nodes;
+                    depthTotal += result.depth;
+                    searches++;
+                }
+            }
+            double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            
+            double nodesPerSecond = nodes / seconds;
+            if (baseline == 0.0)
+            {
+                baseline = nodesPerSecond;
+            }
+            
+            printf("%7d %11.0f %8.2fx %12.0f %11.2f\n", threads, nodesPerSecond, nodesPerSecond / baseline,
+                   nodesPerSecond / threads, searches > 0 ? double(depthTotal) / searches : 0.0);
+        }
+    }
+    
+    // As RunSearchBenchmark, for the Monte Carlo AI
+    void RunMonteCarloBenchmark(long count, int maxThreads, uint64_t seed)
+    {
+        if (maxThreads <= 0)
+        {
+            maxThreads = max(1u, thread::hardware_concurrency());
+        }
+        
+        vector<GameState> positions = MakeSearchPositions(seed, count);
+        
+        vector<int> threadCounts;
+        for (int threads = 1; threads < maxThreads; threads *= 2)
+        {
+            threadCounts.push_back(threads);
+        }
+        threadCounts.push_back(maxThreads);
+        
+        printf("mcts:         %zu positions x 2 players, %.0f ms each\n", positions.size(), SEARCH_BUDGET * 1000);
+        printf("threads playouts/sec   speedup   per thread   per tick\n");
+        
+        double baseline = 0.0;
+        for (int threads : threadCounts)
+        {
+            MonteCarloSearch search(threads);
+            int64_t playouts = 0;
+            
+            auto start = chrono::steady_clock::now();
+            for (const GameState& position : positions)
+            {
+                for (int player = 1; player <= 2; player++)
+                {
+                    playouts += search.Search(position, player, SEARCH_BUDGET).playouts;
+                }
+            }
+            double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            
+            double playoutsPerSecond = playouts / seconds;
+            if (baseline == 0.0)
+            {
+                baseline = playoutsPerSecond;
+            }
+            
+            printf("%7d %13.0f %8.2fx %12.0f %10.0f\n", threads, playoutsPerSecond, playoutsPerSecond / baseline,
+                   playoutsPerSecond / threads, playoutsPerSecond * GameState::tickInterval);
+        }
+    }
+    
+    double Percent(long part, long whole)
+    {
+        return whole > 0 ? 100.0 * part / whole : 0.0;
+    }
+    
+    // One match between two controllers, each given budget seconds per decision
+    MatchResult PlayControllers(IController& controller1, IController& controller2, uint64_t seed, double budget)
+    {
+        GameState game(seed);
+        game.player1.direction = {1, 0};
+        game.player2.direction = {-1, 0};
+        
+        auto budgetDuration = chrono::duration_cast<IController::Clock::duration>(chrono::duration<double>(budget));
+        MatchResult result{0, 0, 0, 0};
+        
+        while (result.ticks < MAX_TICKS_PER_MATCH)
+        {
+            // Both decide on the same position, as in the game
+            Cell move1 = controller1.Decide(game, 1, IController::Clock::now() + budgetDuration);
+            Cell move2 = controller2.Decide(game, 2, IController::Clock::now() + budgetDuration);
+            game.player1.Steer(move1);
+            game.player2.Steer(move2);
+            
+            int score1 = game.score;
+            int score2 = game.score2;
+            TickEvents events = game.Step();
+            result.ticks++;
+            
+            if (events.gameOver)
+            {
+                result.winner = game.winner;
+                result.score1 = score1 + (events.player1Ate ? 1 : 0);
+                result.score2 = score2 + (events.player2Ate ? 1 : 0);
+                return result;
+            }
+        }
+        
+        result.score1 = game.score;
+        result.score2 = game.score2;
+        return result;
+    }
+    
+    // Steps a vector environment with random actions, writing observations,
+    // rewards and done flags as a training loop would
+    void RunEnvBenchmark(long steps, uint64_t seed)
+    {
+        SnakeVecEnv* env = snake_vec_env_create(ENV_BENCH_ENVS, seed);
+        
+        vector<uint64_t> observations(size_t(ENV_BENCH_ENVS) * 2 * SNAKE_VEC_ENV_AGENT_WORDS);
+        vector<float> rewards(size_t(ENV_BENCH_ENVS) * 2);
+        vector<uint8_t> dones(ENV_BENCH_ENVS);
+        vector<uint8_t> actions(size_t(ENV_ACTION_SETS) * ENV_BENCH_ENVS * 2);
+        
+        Random rng(seed);
+        for (uint8_t& action : actions)
+        {
+            action = static_cast<uint8_t>(rng.NextBelow(4));
+        }
+        
+        snake_vec_env_reset(env, observations.data());
+        
+        long batches = max(1L, steps / ENV_BENCH_ENVS);
+        long finished = 0;
+        
+        auto start = chrono::steady_clock::now();
+        for (long batch = 0; batch < batches; batch++)
+        {
+            const uint8_t* batchActions = actions.data() + size_t(batch % ENV_ACTION_SETS) * ENV_BENCH_ENVS * 2;
+            snake_vec_env_step(env, batchActions, observations.data(), rewards.data(), dones.data());
+            
+            for (uint8_t done : dones)
+            {
+                finished += done;
+            }
+        }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        
+        snake_vec_env_destroy(env);
+        
+        long total = batches * ENV_BENCH_ENVS;
+        printf("env:          %d environments, %ld steps in %.3f s\n", ENV_BENCH_ENVS, total, seconds);
+        printf("steps/sec:    %.0f\n", total / seconds);
+        printf("episodes:     %ld (avg %.1f steps)\n", finished, finished > 0 ? double(total) / finished : 0.0);
+    }
+    
+    // Times what lookahead and rollback do per node: saving a position,
+    // restoring it, and copying it to step a move. Also times rebuilding the
+    // free-cell list, the work a smaller snapshot would add to every restore.
+    void RunSnapshotBenchmark(long operations, uint64_t seed)
+    {
+        // At least one position to index, whatever was asked for
+        operations = max(1L, operations);
+        vector<GameState> positions = MakeSearchPositions(seed, min(operations, SNAPSHOT_POSITIONS));
+        vector<GameSnapshot> snapshots(positions.size(), positions[0].Save());
+        GameState scratch = positions[0];
+        GameState* volatile target = &scratch; // Opaque, so no copy is trimmed to the fields read back
+        FreeCells freeCells;
+        long rounds = max(1L, operations / static_cast<long>(positions.size()));
+        long total = rounds * static_cast<long>(positions.size());
+        uint64_t checksum = 0;
+        
+        auto timeEach = [&](auto operation) {
+            auto start = chrono::steady_clock::now();
+            for (long round = 0; round < rounds; round++)
+            {
+                for (size_t i = 0; i < positions.size(); i++)
+                {
+                    operation(i);
+                }
+            }
+            return chrono::duration<double>(chrono::steady_clock::now() - start).count() * 1e9 / total;
+        };
+        
+        double saveNs = timeEach([&](size_t i) { snapshots[i] = positions[i].Save(); });
+        double restoreNs = timeEach([&](size_t i) {
+            target->Restore(snapshots[i]);
+            checksum += target->Hash();
+        });
+        double stepNs = timeEach([&](size_t i) {
+            GameState& next = *target;
+            next = positions[i];
+            checksum += next.Step().gameOver ? 1 : next.Hash();
+        });
+        double rebuildNs = timeEach([&](size_t i) {
+            freeCells.Rebuild(positions[i].player1, positions[i].player2);
+            checksum += freeCells.Count();
+        });
+        
+        printf("snapshot:     %zu bytes, %zu positions, %ld operations each (checksum %016llx)\n",
+               sizeof(GameSnapshot), positions.size(), total, static_cast<unsigned long long>(checksum));
+        printf("save:         %.1f ns\n", saveNs);
+        printf("restore:      %.1f ns\n", restoreNs);
+        printf("copy + step:  %.1f ns (a search node)\n", stepNs);
+        printf("free rebuild: %.1f ns (what a compact snapshot would add per restore)\n", rebuildNs);
+    }
+    
+    // Policy network vs itself. Each task steps its games together and, every
+    // tick, evaluates both snakes of all its running games in one batch.
+    void RunPolicyBenchmark(long games, int threads, uint64_t seed, const char* weightsPath)
+    {
+        PolicyNetwork network;
+        bool trained = network.Load(weightsPath);
+        if (!trained)
+        {
+            network.Randomize({POLICY_HIDDEN_WIDTH, POLICY_HIDDEN_WIDTH / 2}, seed);
+        }
+        
+        ThreadPool pool(threads);
+        BatchStats totals;
+        long inferences = 0;
+        double networkSeconds = 0.0;
+        mutex totalsMutex;
+        
+        auto start = chrono::steady_clock::now();
+        
+        for (long first = 0; first < games; first += POLICY_GAMES_PER_TASK)
+        {
+            int count = static_cast<int>(min(games - first, POLICY_GAMES_PER_TASK));
+            
+            pool.Submit([=, &network, &totals, &inferences, &networkSeconds, &totalsMutex] {
+                vector<GameState> states;
+                vector<int> live(count);
+                vector<int> ticks(count, 0);
+                vector<uint64_t> observations(size_t(count) * 2 * Observation::wordCount);
+                vector<float> logits(size_t(count) * 2 * PolicyNetwork::outputCount);
+                PolicyNetwork::Scratch scratch;
+                
+                states.reserve(count);
+                for (int i = 0; i < count; i++)
+                {
+                    states.emplace_back(seed + first + i);
+                    states[i].player1.direction = {1, 0};
+                    states[i].player2.direction = {-1, 0};
+                    live[i] = i;
+                }
+                
+                BatchStats local;
+                long localInferences = 0;
+                double localSeconds = 0.0;
+                
+                while (!live.empty())
+                {
+                    int batch = static_cast<int>(live.size()) * 2;
+                    for (size_t k = 0; k < live.size(); k++)
+                    {
+                        Observation::Write(states[live[k]], 1, &observations[(2 * k) * Observation::wordCount]);
+                        Observation::Write(states[live[k]], 2, &observations[(2 * k + 1) * Observation::wordCount]);
+                    }
+                    
+                    auto evaluateStart = chrono::steady_clock::now();
+                    network.Evaluate(observations.data(), batch, logits.data(), scratch);
+                    localSeconds += chrono::duration<double>(chrono::steady_clock::now() - evaluateStart).count();
+                    localInferences += batch;
+                    
+                    size_t kept = 0;
+                    for (size_t k = 0; k < live.size(); k++)
+                    {
+                        int i = live[k];
+                        GameState& game = states[i];
+                        Cell move1 = PolicyNetwork::ChooseMove(&logits[(2 * k) * PolicyNetwork::outputCount], game, 1);
+                        Cell move2 = PolicyNetwork::ChooseMove(&logits[(2 * k + 1) * PolicyNetwork::outputCount], game, 2);
+                        game.player1.Steer(move1);
+                        game.player2.Steer(move2);
+                        
+                        // Scores are cleared when the round ends, so remember them first
+                        int score1 = game.score;
+                        int score2 = game.score2;
+                        TickEvents events = game.Step();
+                        ticks[i]++;
+                        
+                        if (events.gameOver)
+                        {
+                            local.Add(MatchResult{game.winner, ticks[i], score1 + (events.player1Ate ? 1 : 0),
+                                                  score2 + (events.player2Ate ? 1 : 0)});
+                        }
+                        else if (ticks[i] == MAX_TICKS_PER_MATCH)
+                        {
+                            local.Add(MatchResult{0, ticks[i], game.score, game.score2});
+                        }
+                        else
+                        {
+                            live[kept++] = i;
+                        }
+                    }
+                    live.resize(kept);
+                }
+                
+                lock_guard<mutex> lock(totalsMutex);
+                totals.Merge(local);
+                inferences += localInferences;
+                networkSeconds += localSeconds;
+            });
+        }
+        pool.Wait();
+        
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        
+        printf("policy:       %s network, %s kernels\n", trained ? weightsPath : "random 2500-64-32-4",
+               PolicyNetwork::KernelName());
+        printf("games:        %ld on %d threads in %.3f s\n", totals.games, pool.ThreadCount(), seconds);
+        printf("inferences:   %ld, %.0f/sec overall, %.0f/sec per thread in the network\n", inferences,
+               inferences / seconds, networkSeconds > 0.0 ? inferences / networkSeconds : 0.0);
+        printf("avg ticks:    %.1f\n", totals.games > 0 ? double(totals.ticks) / totals.games : 0.0);
+        printf("player 1 won: %ld (%.2f%%), player 2 won: %ld (%.2f%%), ties %ld, timeouts %ld\n", totals.wins1,
+               Percent(totals.wins1, totals.games), totals.wins2, Percent(totals.wins2, totals.games), totals.ties,
+               totals.timeouts);
+    }
+    
+    struct LeagueStats
+    {
+        const char* name = "";
+        long wins = 0;
+        long losses = 0;
+        long ties = 0;
+        long timeouts = 0;
+        int64_t decisions = 0;
+        double decisionSeconds = 0.0;
+        double maxDecision = 0.0;
+        
+        void AddLatency(const DecisionLatency& latency)
+        {
+            decisions += latency.count;
+            decisionSeconds += latency.mean * latency.count;
+            maxDecision = max(maxDecision, latency.max);
+        }
+    };
+    
+    // Every AI controller plays every other one games times, swapping sides
+    // each game, and each is reported on strength and decision latency
+    void RunLeague(long games, int threads, uint64_t seed)
+    {
+        ThreadPool pool(threads);
+        LeagueStats stats[IController::kindCount];
+        mutex statsMutex;
+        
+        auto start = chrono::steady_clock::now();
+        
+        for (int a = 0; a < IController::kindCount; a++)
+        {
+            for (int b = a + 1; b < IController::kindCount; b++)
+            {
+                for (long first = 0; first < games; first += LEAGUE_GAMES_PER_TASK)
+                {
+                    long last = min(games, first + LEAGUE_GAMES_PER_TASK);
+                    
+                    pool.Submit([=, &stats, &statsMutex] {
+                        unique_ptr<IController> controllers[2] = {IController::Create(a), IController::Create(b)};
+                        LeagueStats local[2];
+                        
+                        for (long i = first; i < last; i++)
+                        {
+                            // Even games: a is player 1
+                            int side = static_cast<int>(i % 2);
+                            MatchResult result = PlayControllers(*controllers[side], *controllers[1 - side], seed + i, LEAGUE_BUDGET);
+                            
+                            for (int who = 0; who < 2; who++)
+                            {
+                                int player = (who == side) ? 1 : 2;
+                                if (result.winner == 0) local[who].timeouts++;
+                                else if (result.winner == 3) local[who].ties++;
+                                else if (result.winner == player) local[who].wins++;
+                                else local[who].losses++;
+                            }
+                        }
+                        
+                        lock_guard<mutex> lock(statsMutex);
+                        int kinds[2] = {a, b};
+                        for (int who = 0; who < 2; who++)
+                        {
+                            LeagueStats& total = stats[kinds[who]];
+                            total.name = controllers[who]->Name();
+                            total.wins += local[who].wins;
+                            total.losses += local[who].losses;
+                            total.ties += local[who].ties;
+                            total.timeouts += local[who].timeouts;
+                            total.AddLatency(controllers[who]->Latency());
+                        }
+                    });
+                }
+            }
+        }
+        pool.Wait();
+        
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        
+        printf("league:       %ld games per pairing, %.1f ms per decision, on %d threads in %.1f s\n", games,
+               LEAGUE_BUDGET * 1000, pool.ThreadCount(), seconds);
+        printf("controller   wins losses   ties  win%%   mean latency    max latency\n");
+        for (int kind = 0; kind < IController::kindCount; kind++)
+        {
+            const LeagueStats& entry = stats[kind];
+            long played = entry.wins + entry.losses + entry.ties + entry.timeouts;
+            printf("%-10s %6ld %6ld %6ld %5.1f %11.1f us %11.1f us\n", entry.name, entry.wins,
+                   entry.losses, entry.ties, Percent(entry.wins, played),
+                   entry.decisions > 0 ? entry.decisionSeconds * 1e6 / entry.decisions : 0.0, entry.maxDecision * 1e6);
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    long games = argc > 1 ? atol(argv[1]) : DEFAULT_GAMES;
+    int threads = argc > 2 ? atoi(argv[2]) : 0;
+    uint64_t seed = argc > 3 ? strtoull(argv[3], nullptr, 10) : DEFAULT_SEED;
+    
+    if (argc > 4 && strcmp(argv[4], "search") == 0)
+    {
+        RunSearchBenchmark(games, threads, seed);
+        return 0;
+    }
+    
+    if (argc > 4 && strcmp(argv[4], "mcts") == 0)
+    {
+        RunMonteCarloBenchmark(games, threads, seed);
+        return 0;
+    }
+    
+    if (argc > 4 && strcmp(argv[4], "league") == 0)
+    {
+        // The searching AIs play their openings from the book, as in the game
+        OpeningBook::active = make_unique<OpeningBook>(OpeningBook::defaultPath);
+        RunLeague(games, threads, seed);
+        return 0;
+    }
+    
+    if (argc > 4 && strcmp(argv[4], "env") == 0)
+    {
+        RunEnvBenchmark(games, seed);
+        return 0;
+    }
+    
+    if (argc > 4 && strcmp(argv[4], "snapshot") == 0)
+    {
+        RunSnapshotBenchmark(games, seed);
+        return 0;
+    }
+    
+    if (argc > 4 && strcmp(argv[4], "policy") == 0)
+    {
+        RunPolicyBenchmark(games, threads, seed, argc > 5 ? argv[5] : PolicyNetwork::defaultPath);
+        return 0;
+    }
+    
+    if (argc > 4 && strcmp(argv[4], "scalar") != 0)
+    {
+        fprintf(stderr, "snake-batch: unknown mode %s\n%s", argv[4], USAGE);
+        return 1;
+    }
+    
+    unique_ptr<ReplayWriter> replayWriter;
+    if (argc > 5)
+    {
+        replayWriter = make_unique<ReplayWriter>(argv[5]);
+    }
+    
+    ThreadPool pool(threads);
+    BatchStats totals;
+    mutex totalsMutex;
+    
+    auto start = chrono::steady_clock::now();
+    
+    // Match i always uses seed + i, so results don't depend on the thread count
+    for (long first = 0; first < games; first += GAMES_PER_TASK)
+    {
+        long last = min(games, first + GAMES_PER_TASK);
+        
+        pool.Submit([=, &totals, &totalsMutex, &replayWriter] {
+            BatchStats local;
+            ReplayRecorder recorder;
+            ReplayRecorder* replay = replayWriter ? &recorder : nullptr;
+            
+            for (long i = first; i < last; i++)
+            {
+                MatchResult result = Match::PlayAIvsAI(seed + i, MAX_TICKS_PER_MATCH, replay);
+                local.Add(result);
+                
+                if (replay != nullptr)
+                {
+                    replayWriter->Submit(replay->Finish(result.winner));
+                }
+            }
+            
+            lock_guard<mutex> lock(totalsMutex);
+            totals.Merge(local);
+        });
+    }
+    pool.Wait();
+    
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    
+    printf("games:        %ld on %d threads in %.3f s\n", totals.games, pool.ThreadCount(), seconds);
+    printf("games/sec:    %.0f\n", totals.games / seconds);
+    printf("ticks/sec:    %.0f\n", totals.ticks / seconds);
+    printf("avg ticks:    %.1f\n", totals.games > 0 ? double(totals.ticks) / totals.games : 0.0);
+    printf("player 1 won: %ld (%.2f%%), avg score %.2f\n", totals.wins1, Percent(totals.wins1, totals.games),
+           totals.games > 0 ? double(totals.score1) / totals.games : 0.0);
+    printf("player 2 won: %ld (%.2f%%), avg score %.2f\n", totals.wins2, Percent(totals.wins2, totals.games),
+           totals.games > 0 ? double(totals.score2) / totals.games : 0.0);
+    printf("ties:         %ld (%.2f%%)\n", totals.ties, Percent(totals.ties, totals.games));
+    printf("timeouts:     %ld (%.2f%%)\n", totals.timeouts, Percent(totals.timeouts, totals.games));
+    
+    return 0;
+}
@@ -0,0 +1,184 @@
+#include "AlphaBetaSearch.hpp"
+#include "DistanceField.hpp"
+#include "GameState.hpp"
+#include "OpeningBook.hpp"
+#include "ThreadPool.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+// snake-book: builds the opening book the searching AIs probe before
+// searching.
+//
+// Usage: snake-book [ticks] [budget-ms] [threads] [book-file]
+//
+// Rounds always start from the same snake positions, so an opening is fixed
+// by where the first food lands (and the snakes' first directions) until
+// someone eats; after that the food follows the round's seed and positions
+// stop repeating. For every first food cell this plays the first ticks of
+// the round with each player following the book (its own search at
+// budget-ms per move) or the greedy or shortest-path AI, and stores the
+// searched move of both players in every position reached.
+
+namespace
+{
+    constexpr int DEFAULT_TICKS = 40;
+    constexpr double DEFAULT_BUDGET_MS = 20.0;
+    constexpr uint64_t START_SEED = 1; // Only the rng behind later food spawns; the first food is set directly
+    
+    enum class Style
+    {
+        Book,
+        Greedy,
+        Path
+    };
+    
+    // Player 1, player 2 styles of the lines played from each start
+    const Style LINES[][2] = {
+        {Style::Book, Style::Book},
+        {Style::Book, Style::Greedy},
+        {Style::Greedy, Style::Book},
+        {Style::Book, Style::Path},
+        {Style::Path, Style::Book},
+    };
+    
+    // Player 2's first direction: AI vs AI starts it left, Player vs AI right
+    const Cell SECOND_STARTS[] = {{-1, 0}, {1, 0}};
+    
+    class LineBuilder
+    {
+        public:
+            explicit LineBuilder(double budget) : budget(budget) {}
+            
+            // Plays every line from a round starting with food at foodCell
+            void Build(Cell foodCell, Cell secondDirection, int ticks)
+            {
+                for (const auto& line : LINES)
+                {
+                    GameState game(START_SEED);
+                    game.food.position = foodCell;
+                    game.player1.direction = {1, 0};
+                    game.player2.direction = secondDirection;
+                    
+                    for (int tick = 0; tick < ticks; tick++)
+                    {
+                        const OpeningBook::Entry& entry = Lookup(game);
+                        Cell move1 = Move(line[0], entry, game, 1);
+                        Cell move2 = Move(line[1], entry, game, 2);
+                        game.player1.Steer(move1);
+                        game.player2.Steer(move2);
+                        
+                        TickEvents events = game.Step();
+                        if (events.player1Ate || events.player2Ate || events.gameOver)
+                            break;
+                    }
+                }
+            }
+            
+            unordered_map<uint64_t, OpeningBook::Entry> entries;
+            
+        private:
+            // Book entry of the position, searched the first time it is seen
+            const OpeningBook::Entry& Lookup(const GameState& game)
+            {
+                uint64_t hash = game.Hash();
+                auto found = entries.find(hash);
+                if (found != entries.end())
+                    return found->second;
+                
+                OpeningBook::Entry entry{hash, {OpeningBook::noMove, OpeningBook::noMove}, {}};
+                for (int player = 1; player <= 2; player++)
+                {
+                    entry.moves[player - 1] = OpeningBook::MoveCode(search.Search(game, player, budget).move);
+                }
+                return entries.emplace(hash, entry).first->second;
+            }
+            
+            Cell Move(Style style, const OpeningBook::Entry& entry, const GameState& game, int player)
+            {
+                const Snake& own = player == 1 ? game.player1 : game.player2;
+                const Snake& other = player == 1 ? game.player2 : game.player1;
+                
+                switch (style)
+                {
+                    case Style::Greedy:
+                        return own.GetAIDirection(game.food.position, other);
+                    case Style::Path:
+                        distanceField.Compute(game);
+                        return distanceField.BestMove(own);
+                    default:
+                    {
+                        uint8_t code = entry.moves[player - 1];
+                        return code < 4 ? DIRECTIONS[code] : Cell{0, 0};
+                    }
+                }
+            }
+            
+            double budget;
+            AlphaBetaSearch search;
+            DistanceField distanceField;
+    };
+}
+
+int main(int argc, char** argv)
+{
+    int ticks = argc > 1 ? atoi(argv[1]) : DEFAULT_TICKS;
+    double budgetMs = argc > 2 ? atof(argv[2]) : DEFAULT_BUDGET_MS;
+    int threads = argc > 3 ? atoi(argv[3]) : 0;
+    const char* bookPath = argc > 4 ? argv[4] : OpeningBook::defaultPath;
+    
+    GameState start(START_SEED);
+    ThreadPool pool(threads);
+    vector<OpeningBook::Entry> entries;
+    mutex entriesMutex;
+    int openings = 0;
+    
+    auto startTime = chrono::steady_clock::now();
+    
+    // One task per first food cell and start direction, each with its own search
+    for (Cell secondDirection : SECOND_STARTS)
+    {
+        for (int y = 0; y < GameState::cellCount; y++)
+        {
+            for (int x = 0; x < GameState::cellCount; x++)
+            {
+                Cell foodCell{x, y};
+                if (start.OwnerAt(foodCell) != 0)
+                    continue;
+                
+                openings++;
+                pool.Submit([=, &entries, &entriesMutex] {
+                    LineBuilder builder(budgetMs / 1000.0);
+                    builder.Build(foodCell, secondDirection, ticks);
+                    
+                    lock_guard<mutex> lock(entriesMutex);
+                    for (const auto& item : builder.entries)
+                    {
+                        entries.push_back(item.second);
+                    }
+                });
+            }
+        }
+    }
+    pool.Wait();
+    
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+    
+    if (!OpeningBook::Write(bookPath, entries))
+    {
+        fprintf(stderr, "snake-book: cannot write %s\n", bookPath);
+        return 1;
+    }
+    
+    OpeningBook book(bookPath);
+    printf("openings:     %d, up to %d ticks, %.0f ms per search\n", openings, ticks, budgetMs);
+    printf("positions:    %zu in %s\n", book.Size(), bookPath);
+    printf("built in:     %.1f s on %d threads\n", seconds, pool.ThreadCount());
+    return 0;
+}
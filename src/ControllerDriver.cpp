@@ -0,0 +1,55 @@
+#include "ControllerDriver.hpp"
+#include <chrono>
+
+using namespace std;
+
+namespace
+{
+    constexpr double THINK_FRACTION = 0.5; // Of a tick, between ticks
+}
+
+ControllerDriver::ControllerDriver(int player)
+    : player(player)
+{
+}
+
+void ControllerDriver::SetController(shared_ptr<IController> newController)
+{
+    worker.Cancel();
+    controller = move(newController);
+}
+
+void ControllerDriver::Request(const GameState& state, double tickInterval)
+{
+    if (!controller || controller->DecidesAtTick() || !state.running)
+        return;
+    
+    auto deadline = IController::Clock::now()
+                  + chrono::duration_cast<IController::Clock::duration>(chrono::duration<double>(tickInterval * THINK_FRACTION));
+    
+    // The lambda holds its own reference: the controller outlives the
+    // decision even if it is replaced meanwhile
+    worker.Request(state, [thinker = controller, who = player, deadline](const GameState& snapshot) {
+        return thinker->Decide(snapshot, who, deadline);
+    });
+}
+
+void ControllerDriver::Apply(GameState& state)
+{
+    if (!controller || !state.running)
+        return;
+    
+    // A thinking controller that hasn't decided yet (several ticks due in
+    // one frame) leaves the direction alone; Steer rejects reversing
+    Cell move;
+    if (controller->DecidesAtTick())
+    {
+        move = controller->Decide(state, player, IController::Clock::now());
+    }
+    else if (!worker.TryTake(move))
+    {
+        return;
+    }
+    
+    (player == 1 ? state.player1 : state.player2).Steer(move);
+}
@@ -0,0 +1,89 @@
+#include "DecisionWorker.hpp"
+
+using namespace std;
+
+DecisionWorker::DecisionWorker()
+    : hasPending(false),
+      requested(0),
+      result{0, 0},
+      resultReady(false),
+      stopping(false),
+      worker(&DecisionWorker::Loop, this)
+{
+}
+
+DecisionWorker::~DecisionWorker()
+{
+    {
+        lock_guard<mutex> lock(stateMutex);
+        stopping = true;
+    }
+    workAvailable.notify_one();
+    worker.join();
+}
+
+void DecisionWorker::Request(const GameState& state, Decide decide)
+{
+    {
+        lock_guard<mutex> lock(stateMutex);
+        pending = state;
+        pendingDecide = move(decide);
+        hasPending = true;
+        requested++;
+        resultReady = false;
+    }
+    workAvailable.notify_one();
+}
+
+bool DecisionWorker::TryTake(Cell& move)
+{
+    lock_guard<mutex> lock(stateMutex);
+    if (!resultReady)
+        return false;
+    
+    move = result;
+    resultReady = false;
+    return true;
+}
+
+void DecisionWorker::Cancel()
+{
+    lock_guard<mutex> lock(stateMutex);
+    hasPending = false;
+    pendingDecide = nullptr;
+    requested++;
+    resultReady = false;
+}
+
+void DecisionWorker::Loop()
+{
+    GameSnapshot state;
+    
+    while (true)
+    {
+        Decide decide;
+        uint64_t request;
+        {
+            unique_lock<mutex> lock(stateMutex);
+            workAvailable.wait(lock, [this] { return hasPending || stopping; });
+            if (stopping)
+                return;
+            
+            state = pending;
+            decide = move(pendingDecide);
+            request = requested;
+            hasPending = false;
+        }
+        
+        // The lock is not held while deciding: the render thread can keep
+        // requesting and taking
+        Cell decision = decide(state);
+        
+        lock_guard<mutex> lock(stateMutex);
+        if (request == requested)
+        {
+            result = decision;
+            resultReady = true;
+        }
+    }
+}
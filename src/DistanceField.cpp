@@ -0,0 +1,106 @@
+#include "DistanceField.hpp"
+#include <algorithm>
+#include <tuple>
+
+using namespace std;
+
+namespace
+{
+    constexpr int16_t WALL = -2; // Border or snake: never enqueued
+}
+
+DistanceField::DistanceField()
+{
+    fill(begin(distance), end(distance), WALL);
+    blocked.Clear();
+}
+
+void DistanceField::Compute(const GameState& state)
+{
+    for (int i = 0; i < Bitboard::wordCount; i++)
+    {
+        blocked.words[i] = state.player1.Occupancy().words[i] | state.player2.Occupancy().words[i];
+    }
+    floodFill.Load(state);
+    
+    // Snake cells count as walls; the border stays a wall from construction
+    for (int y = 0; y < Bitboard::cellCount; y++)
+    {
+        for (int x = 0; x < Bitboard::cellCount; x++)
+        {
+            int index = Bitboard::Index(Cell{x, y});
+            bool isBlocked = (blocked.words[index >> 6] >> (index & 63)) & 1;
+            distance[(y + 1) * stride + x + 1] = isBlocked ? WALL : static_cast<int16_t>(unreachable);
+        }
+    }
+    
+    Cell target = state.food.position;
+    if (!Bitboard::InBounds(target) || blocked.Test(target))
+        return;
+    
+    int head = 0;
+    int tail = 0;
+    int start = Padded(target);
+    distance[start] = 0;
+    queue[tail++] = static_cast<int16_t>(start);
+    
+    auto visit = [&](int next, int16_t nextDistance)
+    {
+        if (distance[next] == unreachable)
+        {
+            distance[next] = nextDistance;
+            queue[tail++] = static_cast<int16_t>(next);
+        }
+    };
+    
+    while (head < tail)
+    {
+        int index = queue[head++];
+        int16_t nextDistance = static_cast<int16_t>(distance[index] + 1);
+        
+        visit(index - stride, nextDistance);
+        visit(index + stride, nextDistance);
+        visit(index - 1, nextDistance);
+        visit(index + 1, nextDistance);
+    }
+}
+
+Cell DistanceField::BestMove(const Snake& snake) const
+{
+    Cell head = snake.body[0];
+    int length = snake.body.size();
+    
+    // Roomy moves first. Among those a path to the food wins, shorter
+    // being better; otherwise the move with more room wins.
+    auto rank = [&](int room, int d)
+    {
+        bool roomy = room >= length;
+        bool toFood = roomy && d != unreachable;
+        return make_tuple(roomy, toFood, toFood ? -d : room);
+    };
+    
+    Cell bestDirection = {0, 0};
+    auto bestRank = make_tuple(false, false, 0);
+    
+    for (const auto& dir : DIRECTIONS)
+    {
+        // Don't reverse direction
+        if (dir.x == -snake.direction.x && dir.y == -snake.direction.y)
+            continue;
+        
+        Cell newPos = head + dir;
+        if (!Bitboard::InBounds(newPos) || blocked.Test(newPos))
+            continue;
+        
+        // A move into a pocket smaller than the snake is a slow death
+        auto moveRank = rank(floodFill.Fill(newPos).area, At(newPos));
+        
+        if (bestDirection == Cell{0, 0} || moveRank > bestRank)
+        {
+            bestDirection = dir;
+            bestRank = moveRank;
+        }
+    }
+    
+    return bestDirection;
+}
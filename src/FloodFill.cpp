@@ -0,0 +1,281 @@
+#include "FloodFill.hpp"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace
+{
+    constexpr int ROWS = Bitboard::cellCount;
+    constexpr uint32_t ROW_MASK = (uint32_t{1} << Bitboard::cellCount) - 1;
+    
+    // A column of FloodFill's blocks: eight rows, one AVX2 register
+    constexpr int BLOCK_ROWS = 8;
+    constexpr int BLOCK_COUNT = (ROWS + BLOCK_ROWS - 1) / BLOCK_ROWS;
+    
+    // The kernels' registers (GCC/Clang vector extension). The generic
+    // kernel works on half columns: a 256-bit vector on a 128-bit target
+    // gets split through the stack.
+    typedef uint32_t WideBlock __attribute__((vector_size(32)));
+    typedef uint32_t HalfBlock __attribute__((vector_size(16)));
+    
+    // Blocks are passed by reference throughout: a 256-bit vector by value
+    // has a different ABI with and without AVX
+    struct GenericOps
+    {
+        typedef HalfBlock Block;
+        
+        __attribute__((always_inline)) static bool AnyBits(const HalfBlock& block)
+        {
+            uint32_t bits = 0;
+            for (int i = 0; i < 4; i++)
+            {
+                bits |= block[i];
+            }
+            return bits != 0;
+        }
+        
+        // Lanes moved one up, the top lane of before shifted in
+        __attribute__((always_inline)) static void ShiftIn(const HalfBlock& before, const HalfBlock& block, HalfBlock& shifted)
+        {
+            shifted = __builtin_shufflevector(before, block, 3, 4, 5, 6);
+        }
+        
+        // Lanes moved one down, the bottom lane of after shifted in
+        __attribute__((always_inline)) static void ShiftOut(const HalfBlock& block, const HalfBlock& after, HalfBlock& shifted)
+        {
+            shifted = __builtin_shufflevector(block, after, 1, 2, 3, 4);
+        }
+    };
+    
+#if defined(__x86_64__) || defined(__i386__)
+    // Whole columns, and one vptest instead of folding the lanes together
+    struct Avx2Ops
+    {
+        typedef WideBlock Block;
+        
+        __attribute__((target("avx2"))) static bool AnyBits(const WideBlock& block)
+        {
+            __m256i bits = (__m256i)block;
+            return !_mm256_testz_si256(bits, bits);
+        }
+        
+        __attribute__((target("avx2"))) static void ShiftIn(const WideBlock& before, const WideBlock& block, WideBlock& shifted)
+        {
+            shifted = __builtin_shufflevector(before, block, 7, 8, 9, 10, 11, 12, 13, 14);
+        }
+        
+        __attribute__((target("avx2"))) static void ShiftOut(const WideBlock& block, const WideBlock& after, WideBlock& shifted)
+        {
+            shifted = __builtin_shufflevector(block, after, 1, 2, 3, 4, 5, 6, 7, 8);
+        }
+    };
+#endif
+    
+    template <typename Block>
+    __attribute__((always_inline)) inline int PopCount(const Block& block)
+    {
+        int count = 0;
+        for (int i = 0; i < int(sizeof(Block) / sizeof(uint32_t)); i++)
+        {
+            count += __builtin_popcount(block[i]);
+        }
+        return count;
+    }
+    
+    // The fill itself, on FloodFill's interleaved rows. Inlined into both
+    // kernels below, so each is compiled for its own instruction set; the
+    // copy without layer sizes keeps every block in a register.
+    template <typename Ops, bool countLayers>
+    __attribute__((always_inline)) inline ReachableArea FillRows(const uint32_t* open, Cell start, int* layerSizes)
+    {
+        typedef typename Ops::Block Block;
+        constexpr int LANES = sizeof(Block) / sizeof(uint32_t);
+        constexpr int PARTS = BLOCK_ROWS / LANES;
+        constexpr int COUNT = PARTS * BLOCK_COUNT;
+        
+        // Block j holds lanes [LANES * (j / BLOCK_COUNT), +LANES) of column
+        // j % BLOCK_COUNT, so the row above block j's is still the same
+        // lane of block j - 1, or one lane over for a column's first block
+        auto Rows = [open](int j) { return open + (j % BLOCK_COUNT) * BLOCK_ROWS + (j / BLOCK_COUNT) * LANES; };
+        
+        // The whole board fits in 2 * COUNT registers: the free cells not
+        // reached yet and the cells reached in the last layer
+        // (built in registers: a scalar store into a block, or a block
+        // loaded from narrower stores, stalls store forwarding)
+        const Block empty = {};
+        Block lanes;
+        for (int i = 0; i < LANES; i++)
+        {
+            lanes[i] = i;
+        }
+        int startLane = start.y / BLOCK_COUNT;
+        Block startRow = (Block)(lanes == uint32_t(startLane % LANES)) & (uint32_t{1} << start.x);
+        int startBlock = startLane / LANES * BLOCK_COUNT + start.y % BLOCK_COUNT;
+        
+        Block remaining[COUNT];
+        Block frontier[COUNT];
+        #pragma GCC unroll 8
+        for (int j = 0; j < COUNT; j++)
+        {
+            memcpy(&remaining[j], Rows(j), sizeof(Block));
+            frontier[j] = j == startBlock ? startRow : empty;
+            remaining[j] &= ~frontier[j];
+        }
+        
+        if constexpr (countLayers)
+        {
+            layerSizes[0] = 1;
+        }
+        
+        int depth = 0;
+        
+        while (true)
+        {
+            // Grow the whole frontier by one step: left/right is a shift
+            // within each row, up/down comes from the neighbouring blocks
+            Block next[COUNT];
+            Block any = {};
+            #pragma GCC unroll 8
+            for (int j = 0; j < COUNT; j++)
+            {
+                int k = j % BLOCK_COUNT;
+                Block above = k > 0 ? frontier[j - 1] : empty;
+                Block below = k + 1 < BLOCK_COUNT ? frontier[j + 1] : empty;
+                if (k == 0)
+                {
+                    Ops::ShiftIn(j > 0 ? frontier[j - 1] : empty, frontier[j + BLOCK_COUNT - 1], above);
+                }
+                if (k + 1 == BLOCK_COUNT)
+                {
+                    Ops::ShiftOut(frontier[j - BLOCK_COUNT + 1], j + 1 < COUNT ? frontier[j + 1] : empty, below);
+                }
+                
+                next[j] = ((frontier[j] << 1) | (frontier[j] >> 1) | above | below) & remaining[j];
+                any |= next[j];
+            }
+            
+            if (!Ops::AnyBits(any))
+                break;
+            
+            depth++;
+            int layerSize = 0;
+            #pragma GCC unroll 8
+            for (int j = 0; j < COUNT; j++)
+            {
+                remaining[j] &= ~next[j];
+                frontier[j] = next[j];
+                
+                if constexpr (countLayers)
+                {
+                    layerSize += PopCount(next[j]);
+                }
+            }
+            
+            if constexpr (countLayers)
+            {
+                layerSizes[depth] = layerSize;
+            }
+        }
+        
+        // Reached = free before the fill and not free after it
+        int area = 0;
+        for (int j = 0; j < COUNT; j++)
+        {
+            Block freeRows;
+            memcpy(&freeRows, Rows(j), sizeof(freeRows));
+            area += PopCount(freeRows & ~remaining[j]);
+        }
+        
+        return ReachableArea{area, depth};
+    }
+    
+    ReachableArea FillGeneric(const uint32_t* open, Cell start, int* layerSizes)
+    {
+        return layerSizes != nullptr ? FillRows<GenericOps, true>(open, start, layerSizes)
+                                     : FillRows<GenericOps, false>(open, start, layerSizes);
+    }
+    
+#if defined(__x86_64__) || defined(__i386__)
+    __attribute__((target("avx2")))
+    ReachableArea FillAvx2(const uint32_t* open, Cell start, int* layerSizes)
+    {
+        return layerSizes != nullptr ? FillRows<Avx2Ops, true>(open, start, layerSizes)
+                                     : FillRows<Avx2Ops, false>(open, start, layerSizes);
+    }
+#endif
+    
+    typedef ReachableArea (*FillKernel)(const uint32_t* open, Cell start, int* layerSizes);
+    
+    // Picked once, from what the CPU running the program supports
+    FillKernel SelectFill()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return FillAvx2;
+        }
+#endif
+        return FillGeneric;
+    }
+    
+    const FillKernel fillKernel = SelectFill();
+}
+
+FloodFill::FloodFill()
+{
+    fill(begin(open), end(open), 0u);
+}
+
+void FloodFill::Load(const GameState& state)
+{
+    Bitboard blocked;
+    for (int i = 0; i < Bitboard::wordCount; i++)
+    {
+        blocked.words[i] = state.player1.Occupancy().words[i] | state.player2.Occupancy().words[i];
+    }
+    
+    // Repack the 64-bit words into one word per row
+    for (int y = 0; y < ROWS; y++)
+    {
+        int first = y * Bitboard::cellCount;
+        int word = first >> 6;
+        int shift = first & 63;
+        
+        uint64_t bits = blocked.words[word] >> shift;
+        if (shift > 64 - Bitboard::cellCount && word + 1 < Bitboard::wordCount)
+        {
+            bits |= blocked.words[word + 1] << (64 - shift);
+        }
+        
+        open[Slot(y)] = ~static_cast<uint32_t>(bits) & ROW_MASK;
+    }
+}
+
+ReachableArea FloodFill::Fill(Cell start, int* layerSizes) const
+{
+    static_assert(blockRows == BLOCK_ROWS && blockCount == BLOCK_COUNT, "kernels and row layout disagree");
+    
+    if (!IsFree(start))
+        return ReachableArea{0, 0};
+    
+    return fillKernel(open, start, layerSizes);
+}
+
+void FloodFill::EvaluateMoves(const Snake& snake, ReachableArea areas[4]) const
+{
+    Cell head = snake.body[0];
+    
+    for (int i = 0; i < 4; i++)
+    {
+        Cell dir = DIRECTIONS[i];
+        bool reverses = dir.x == -snake.direction.x && dir.y == -snake.direction.y;
+        
+        areas[i] = reverses ? ReachableArea{0, 0} : Fill(head + dir);
+    }
+}
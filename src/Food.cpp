@@ -1,43 +1,17 @@
 #include "Food.hpp"
-#include "Global.hpp"
-#include "raylib.h"
-#include <deque>
 
-using namespace std;
-
-Food::Food(const deque<Vector2>& snakeBody, int cellCount) : cellCount(cellCount)
-{
-    Image image = LoadImage("Assets/Graphics/Sprites/Food_Cherry.png");
-    texture = LoadTextureFromImage(image);
-    UnloadImage(image);
-    position = GenerateRandomPos(snakeBody);
-}
-
-Food::~Food()
-{
-    UnloadTexture(texture);
-}
-
-void Food::Draw(int cellSize, int borderSize) const
-{
-    DrawTexture(texture, borderSize + position.x * cellSize, borderSize + position.y * cellSize, WHITE);
-}
-
-Vector2 Food::GenerateRandomCell() const
+Food::Food()
+    : position{0, 0}
 {
-    float x = GetRandomValue(0, cellCount - 1);
-    float y = GetRandomValue(0, cellCount - 1);
-    return Vector2{x, y};
 }
 
-Vector2 Food::GenerateRandomPos(const deque<Vector2>& snakeBody)
+Cell Food::GenerateRandomPos(const FreeCells& freeCells, Random& rng) const
 {
-    Vector2 newPosition = GenerateRandomCell();
-    
-    while (Global::ElementInDeque(newPosition, snakeBody))
+    // Board completely filled - park the food off the board
+    if (freeCells.Count() == 0)
     {
-        newPosition = GenerateRandomCell();
+        return Cell{-1, -1};
     }
     
-    return newPosition;
-}
\ No newline at end of file
+    return freeCells.At(static_cast<int>(rng.NextBelow(freeCells.Count())));
+}
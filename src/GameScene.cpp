@@ -13,19 +13,22 @@ namespace
 
 GameScene::GameScene()
     : Scene("Game", 1),
+      keyboard1(std::make_shared<KeyboardController>(KEY_W, KEY_S, KEY_A, KEY_D)),
+      keyboard2(std::make_shared<KeyboardController>(KEY_UP, KEY_DOWN, KEY_LEFT, KEY_RIGHT)),
+      driver1(1),
+      driver2(2),
       gameUpdateInterval(GAME_UPDATE_INTERVAL),
       waitingForPlayers(true),
-      readyPulseTimer(0.0f),
-      player1NextDirection{0, 0},
-      player2NextDirection{0, 0},
-      player1DirectionChanged(false),
-      player2DirectionChanged(false)
+      readyPulseTimer(0.0f)
 {
+    driver1.SetController(keyboard1);
+    driver2.SetController(keyboard2);
 }
 
 void GameScene::OnLoad()
 {
     game = std::make_unique<Game>();
+    game->clock.interval = gameUpdateInterval;
     global = std::make_unique<Global>();
     
     // Don't start the game immediately - wait for players
@@ -33,10 +36,8 @@ void GameScene::OnLoad()
     waitingForPlayers = true;
     readyPulseTimer = 0.0f;
     
-    player1NextDirection = {0, 0};
-    player2NextDirection = {0, 0};
-    player1DirectionChanged = false;
-    player2DirectionChanged = false;
+    keyboard1->Clear();
+    keyboard2->Clear();
 }
 
 void GameScene::Update()
@@ -70,24 +71,17 @@ void GameScene::Update()
         UpdateMusicStream(Global::easyAndNormalModeMusic);
     }
     
-    // Handle input
-    HandleInput();
+    // Player 1 - WASD, player 2 - arrow keys, one turn each buffered per tick
+    keyboard1->Poll(game->player1);
+    keyboard2->Poll(game->player2);
     
-    // Update game logic at fixed interval
-    if (Global::EventTriggered(gameUpdateInterval))
+    // Run every fixed-interval tick that is due this frame
+    int ticksDue = game->clock.Advance();
+    for (int i = 0; i < ticksDue; i++)
     {
-        // Apply buffered direction changes before updating
-        if (player1DirectionChanged)
-        {
-            game->player1.direction = player1NextDirection;
-            player1DirectionChanged = false;
-        }
-        if (player2DirectionChanged)
-        {
-            game->player2.direction = player2NextDirection;
-            player2DirectionChanged = false;
-        }
-        
+        // Both buffered turns, then the tick
+        driver1.Apply(*game);
+        driver2.Apply(*game);
         game->Update();
     }
     
@@ -204,85 +198,6 @@ void GameScene::DrawUI() const
     );
 }
 
-void GameScene::HandleInput()
-{
-    // Get the actual current direction from body position (head vs second segment)
-    Vector2 player1ActualDirection = game->player1.direction;
-    Vector2 player2ActualDirection = game->player2.direction;
-    
-    if (game->player1.body.size() >= 2)
-    {
-        Vector2 head = game->player1.body[0];
-        Vector2 neck = game->player1.body[1];
-        player1ActualDirection = {head.x - neck.x, head.y - neck.y};
-    }
-    
-    if (game->player2.body.size() >= 2)
-    {
-        Vector2 head = game->player2.body[0];
-        Vector2 neck = game->player2.body[1];
-        player2ActualDirection = {head.x - neck.x, head.y - neck.y};
-    }
-    
-    // Player 1 - WASD controls (only allow one direction change per update)
-    if (!player1DirectionChanged)
-    {
-        if (IsKeyPressed(KEY_W) && player1ActualDirection.y != 1)
-        {
-            game->running = true;
-            player1NextDirection = {0, -1};
-            player1DirectionChanged = true;
-        }
-        else if (IsKeyPressed(KEY_S) && player1ActualDirection.y != -1)
-        {
-            game->running = true;
-            player1NextDirection = {0, 1};
-            player1DirectionChanged = true;
-        }
-        else if (IsKeyPressed(KEY_A) && player1ActualDirection.x != 1)
-        {
-            game->running = true;
-            player1NextDirection = {-1, 0};
-            player1DirectionChanged = true;
-        }
-        else if (IsKeyPressed(KEY_D) && player1ActualDirection.x != -1)
-        {
-            game->running = true;
-            player1NextDirection = {1, 0};
-            player1DirectionChanged = true;
-        }
-    }
-    
-    // Player 2 - Arrow key controls (only allow one direction change per update)
-    if (!player2DirectionChanged)
-    {
-        if (IsKeyPressed(KEY_UP) && player2ActualDirection.y != 1)
-        {
-            game->running = true;
-            player2NextDirection = {0, -1};
-            player2DirectionChanged = true;
-        }
-        else if (IsKeyPressed(KEY_DOWN) && player2ActualDirection.y != -1)
-        {
-            game->running = true;
-            player2NextDirection = {0, 1};
-            player2DirectionChanged = true;
-        }
-        else if (IsKeyPressed(KEY_LEFT) && player2ActualDirection.x != 1)
-        {
-            game->running = true;
-            player2NextDirection = {-1, 0};
-            player2DirectionChanged = true;
-        }
-        else if (IsKeyPressed(KEY_RIGHT) && player2ActualDirection.x != -1)
-        {
-            game->running = true;
-            player2NextDirection = {1, 0};
-            player2DirectionChanged = true;
-        }
-    }
-}
-
 void GameScene::OnUnload()
 {
     // Clean up game and global instances
@@ -342,8 +257,8 @@ void GameScene::DrawReadyScreen() const
 void GameScene::CheckReadyInput()
 {
     // Detect which direction each player is pressing
-    Vector2 player1Dir = {0, 0};
-    Vector2 player2Dir = {0, 0};
+    Cell player1Dir = {0, 0};
+    Cell player2Dir = {0, 0};
     
     // Player 1 input detection
     if (IsKeyDown(KEY_W)) player1Dir = {0, -1};
@@ -363,9 +278,14 @@ void GameScene::CheckReadyInput()
     
     if (player1Ready && player2Ready)
     {
+        // Fresh, recorded round
+        game->BeginRound();
+        
         // Set initial directions
         game->player1.direction = player1Dir;
         game->player2.direction = player2Dir;
+        keyboard1->Clear();
+        keyboard2->Clear();
         
         // Start the game
         game->running = true;
@@ -0,0 +1,186 @@
+#include "GameState.hpp"
+
+GameState::GameState()
+    : GameState(Random::MakeSeed())
+{
+}
+
+GameState::GameState(uint64_t seed)
+    : player1(),
+      player2(Cell{18, 15}, Cell{-1, 0}),
+      food(),
+      score(0),
+      score2(0),
+      running(true),
+      winner(0),
+      seed(seed),
+      rng(seed),
+      events{false, false, false}
+{
+    freeCells.Rebuild(player1, player2);
+    food.position = food.GenerateRandomPos(freeCells, rng);
+}
+
+TickEvents GameState::Step()
+{
+    events = TickEvents{false, false, false};
+    
+    if (running)
+    {
+        Cell tail1 = player1.body.back();
+        Cell tail2 = player2.body.back();
+        
+        player1.Update();
+        player2.Update();
+        
+        // Only the vacated tails and the new heads can have changed occupancy
+        SyncFreeCell(tail1);
+        SyncFreeCell(tail2);
+        SyncFreeCell(player1.body[0]);
+        SyncFreeCell(player2.body[0]);
+        
+        CheckCollisionWithFood();
+        CheckCollisionWithEdges();
+        CheckCollisionWithTail();
+    }
+    
+    return events;
+}
+
+void GameState::ResetRound()
+{
+    player1.Reset();
+    player2.Reset();
+    
+    freeCells.Rebuild(player1, player2);
+    food.position = food.GenerateRandomPos(freeCells, rng);
+    running = false;
+    score = 0;
+    score2 = 0;
+}
+
+void GameState::SyncFreeCell(Cell cell)
+{
+    if (!Bitboard::InBounds(cell))
+        return;
+    
+    if (OwnerAt(cell) == 0)
+        freeCells.Add(cell);
+    else
+        freeCells.Remove(cell);
+}
+
+void GameState::NewRound(uint64_t newSeed)
+{
+    seed = newSeed;
+    rng.Seed(newSeed);
+    ResetRound();
+    winner = 0;
+}
+
+int GameState::OwnerAt(Cell cell) const
+{
+    if (player1.Occupies(cell))
+        return 1;
+    if (player2.Occupies(cell))
+        return 2;
+    return 0;
+}
+
+void GameState::CheckCollisionWithFood()
+{
+    if (player1.body[0] == food.position)
+    {
+        food.position = food.GenerateRandomPos(freeCells, rng);
+        player1.addSegment = true;
+        score++;
+        events.player1Ate = true;
+    }
+    
+    if (player2.body[0] == food.position)
+    {
+        food.position = food.GenerateRandomPos(freeCells, rng);
+        player2.addSegment = true;
+        score2++;
+        events.player2Ate = true;
+    }
+}
+
+void GameState::CheckCollisionWithEdges()
+{
+    bool p1HitWall = (player1.body[0].x == cellCount || player1.body[0].x == -1 || 
+                      player1.body[0].y == cellCount || player1.body[0].y == -1);
+    bool p2HitWall = (player2.body[0].x == cellCount || player2.body[0].x == -1 || 
+                      player2.body[0].y == cellCount || player2.body[0].y == -1);
+    
+    if (p1HitWall && p2HitWall)
+    {
+        // Both hit walls - decide by score
+        DeclareWinner(score > score2 ? 1 : (score2 > score ? 2 : 3));
+    }
+    else if (p1HitWall)
+    {
+        // Player 1 hit wall - Player 2 wins
+        DeclareWinner(2);
+    }
+    else if (p2HitWall)
+    {
+        // Player 2 hit wall - Player 1 wins
+        DeclareWinner(1);
+    }
+}
+
+void GameState::CheckCollisionWithTail()
+{
+    Cell head1 = player1.body[0];
+    Cell head2 = player2.body[0];
+    
+    // Check if player1 hits its own tail
+    bool p1HitSelf = player1.hitSelf;
+    
+    // Check if player2 hits its own tail
+    bool p2HitSelf = player2.hitSelf;
+    
+    // Check head-to-head collision
+    bool headToHead = head1 == head2;
+    
+    // Check if player1 hits player2's body (not head)
+    bool p1HitP2Body = !headToHead && player2.Occupies(head1);
+    
+    // Check if player2 hits player1's body (not head)
+    bool p2HitP1Body = !headToHead && player1.Occupies(head2);
+    
+    // Determine winner based on collision type
+    if (headToHead)
+    {
+        // Head-to-head collision - decide by score
+        DeclareWinner(score > score2 ? 1 : (score2 > score ? 2 : 3));
+    }
+    else if (p1HitSelf && p2HitSelf)
+    {
+        // Both ate themselves - decide by score
+        DeclareWinner(score > score2 ? 1 : (score2 > score ? 2 : 3));
+    }
+    else if (p1HitP2Body && p2HitP1Body)
+    {
+        // Both hit each other's bodies - decide by score
+        DeclareWinner(score > score2 ? 1 : (score2 > score ? 2 : 3));
+    }
+    else if (p1HitSelf || p1HitP2Body)
+    {
+        // Player 1 at fault - Player 2 wins
+        DeclareWinner(2);
+    }
+    else if (p2HitSelf || p2HitP1Body)
+    {
+        // Player 2 at fault - Player 1 wins
+        DeclareWinner(1);
+    }
+}
+
+void GameState::DeclareWinner(int winnerNum)
+{
+    winner = winnerNum;
+    events.gameOver = true;
+    ResetRound();
+}
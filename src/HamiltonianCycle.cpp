@@ -0,0 +1,61 @@
+#include "HamiltonianCycle.hpp"
+
+using namespace std;
+
+namespace
+{
+    // Shortcuts stop once the snake fills this share of the cycle; from then
+    // on it only follows the cycle, which is always safe
+    constexpr int SHORTCUT_MAX_FILL_PERCENT = 50;
+    
+    // Cells kept between a shortcut's landing cell and the tail, so the food
+    // eaten in the meantime cannot grow the body into the gap
+    constexpr int SHORTCUT_TAIL_MARGIN = 4;
+}
+
+Cell HamiltonianCycle::BestMove(const Snake& snake, const Snake& opponent, Cell food)
+{
+    static_assert(MakeTables().count == length, "the cycle must visit every cell it covers");
+    
+    Cell head = snake.body[0];
+    if (!Bitboard::InBounds(head))
+        return snake.direction;
+    
+    int headIndex = Bitboard::Index(head);
+    int headPosition = tables.position[headIndex];
+    int tailDistance = Ahead(headPosition, Position(snake.body.back()));
+    int foodDistance = Ahead(headPosition, Position(food));
+    bool shortcuts = snake.body.size() * 100 < length * SHORTCUT_MAX_FILL_PERCENT;
+    
+    int best = -1;
+    int bestProgress = 0;
+    int fallback = -1; // Any free cell, for when the opponent blocks the cycle
+    
+    for (int move = 0; move < 4; move++)
+    {
+        Cell next = head + DIRECTIONS[move];
+        if (!Bitboard::InBounds(next) || snake.Occupies(next) || opponent.Occupies(next))
+            continue;
+        
+        if (fallback < 0)
+            fallback = move;
+        
+        // Following the cycle is progress 1; a shortcut skips ahead, but
+        // never onto or past the food's position unless it lands on the
+        // food, and never close to the tail. Two cells can share a position
+        // (odd boards): take the one with the food.
+        int progress = Ahead(headPosition, tables.neighbours[headIndex][move]);
+        bool beforeFood = progress < foodDistance || next == food;
+        bool allowed = progress == 1 || (shortcuts && beforeFood && progress < tailDistance - SHORTCUT_TAIL_MARGIN);
+        
+        if (allowed && (progress > bestProgress || (progress == bestProgress && next == food)))
+        {
+            best = move;
+            bestProgress = progress;
+        }
+    }
+    
+    if (best < 0)
+        best = fallback;
+    return best >= 0 ? DIRECTIONS[best] : Cell{0, 0};
+}
@@ -0,0 +1,49 @@
+#include "IController.hpp"
+#include "AIControllers.hpp"
+
+using namespace std;
+
+unique_ptr<IController> IController::Create(int kind, int threadCount)
+{
+    switch (kind)
+    {
+        case kindGreedy: return make_unique<GreedyController>();
+        case kindCycle: return make_unique<CycleController>();
+        case kindSearch: return make_unique<SearchController>(threadCount);
+        case kindMCTS: return make_unique<MonteCarloController>(threadCount);
+        case kindTuned: return make_unique<TunedController>(AIWeights::active);
+        case kindPolicy: return make_unique<PolicyController>(PolicyNetwork::active);
+        default: return make_unique<PathController>();
+    }
+}
+
+Cell IController::Decide(const GameState& state, int player, Clock::time_point deadline)
+{
+    auto start = Clock::now();
+    Cell move = Choose(state, player, deadline);
+    int64_t nanoseconds = chrono::duration_cast<chrono::nanoseconds>(Clock::now() - start).count();
+    
+    // Only the deciding thread writes, so plain load/store pairs are enough
+    lastNanoseconds.store(nanoseconds, memory_order_relaxed);
+    if (nanoseconds > maxNanoseconds.load(memory_order_relaxed))
+    {
+        maxNanoseconds.store(nanoseconds, memory_order_relaxed);
+    }
+    totalNanoseconds.fetch_add(nanoseconds, memory_order_relaxed);
+    decisions.fetch_add(1, memory_order_relaxed);
+    
+    return move;
+}
+
+DecisionLatency IController::Latency() const
+{
+    int64_t count = decisions.load(memory_order_relaxed);
+    int64_t total = totalNanoseconds.load(memory_order_relaxed);
+    
+    return DecisionLatency{
+        lastNanoseconds.load(memory_order_relaxed) * 1e-9,
+        count > 0 ? total * 1e-9 / count : 0.0,
+        maxNanoseconds.load(memory_order_relaxed) * 1e-9,
+        count
+    };
+}
@@ -0,0 +1,42 @@
+#include "KeyboardController.hpp"
+#include "raylib.h"
+
+KeyboardController::KeyboardController(int upKey, int downKey, int leftKey, int rightKey)
+    : keys{upKey, downKey, leftKey, rightKey},
+      nextDirection{0, 0}
+{
+}
+
+void KeyboardController::Poll(const Snake& snake)
+{
+    // Only one turn per tick
+    if (nextDirection != Cell{0, 0})
+        return;
+    
+    // The direction actually moved last tick (head vs second segment), so
+    // two quick turns can't reverse into the neck
+    Cell actualDirection = snake.direction;
+    if (snake.body.size() >= 2)
+    {
+        Cell head = snake.body[0];
+        Cell neck = snake.body[1];
+        actualDirection = {head.x - neck.x, head.y - neck.y};
+    }
+    
+    for (int i = 0; i < 4; i++)
+    {
+        Cell direction = DIRECTIONS[i];
+        if (IsKeyPressed(keys[i]) && direction != Cell{-actualDirection.x, -actualDirection.y})
+        {
+            nextDirection = direction;
+            return;
+        }
+    }
+}
+
+Cell KeyboardController::Choose(const GameState&, int, Clock::time_point)
+{
+    Cell direction = nextDirection;
+    nextDirection = {0, 0};
+    return direction;
+}
@@ -10,8 +10,13 @@ MainMenuScene::MainMenuScene()
       titleColor(RAYWHITE),
       titlePulseTimer(0.0f),
       selectedOption(0),
+      driver1(1),
+      driver2(2),
       gameUpdateInterval(0.2)
 {
+    // Shortest-path AIs on both sides
+    driver1.SetController(IController::Create(IController::kindPath));
+    driver2.SetController(IController::Create(IController::kindPath));
 }
 
 void MainMenuScene::OnLoad()
@@ -21,12 +26,15 @@ void MainMenuScene::OnLoad()
     
     // Initialize background AI battle (with sounds disabled)
     backgroundGame = std::make_unique<Game>(false);
+    backgroundGame->clock.interval = gameUpdateInterval;
     backgroundGlobal = std::make_unique<Global>();
     
     // Start the background game immediately
     backgroundGame->running = true;
     backgroundGame->player1.direction = {1, 0};  // Start moving right
     backgroundGame->player2.direction = {-1, 0}; // Start moving left
+    driver1.Request(*backgroundGame, gameUpdateInterval);
+    driver2.Request(*backgroundGame, gameUpdateInterval);
 }
 
 void MainMenuScene::Update()
@@ -37,30 +45,36 @@ void MainMenuScene::Update()
     if (!backgroundGame->running)
     {
         backgroundGame = std::make_unique<Game>(false);
+        backgroundGame->clock.interval = gameUpdateInterval;
         backgroundGame->running = true;
         backgroundGame->player1.direction = {1, 0};
         backgroundGame->player2.direction = {-1, 0};
+        driver1.Request(*backgroundGame, gameUpdateInterval);
+        driver2.Request(*backgroundGame, gameUpdateInterval);
     }
     
-    // Update background AI battle
-    UpdateBackgroundAI();
-    
-    // Update game logic at fixed interval
-    if (Global::EventTriggered(gameUpdateInterval))
+    // Run every fixed-interval tick that is due this frame
+    int ticksDue = backgroundGame->clock.Advance();
+    for (int i = 0; i < ticksDue; i++)
     {
+        // Update background AI battle
+        driver1.Apply(*backgroundGame);
+        driver2.Apply(*backgroundGame);
         backgroundGame->Update();
+        driver1.Request(*backgroundGame, gameUpdateInterval);
+        driver2.Request(*backgroundGame, gameUpdateInterval);
     }
     
     // Navigation
     if (IsKeyPressed(KEY_W) || IsKeyPressed(KEY_UP))
     {
         selectedOption--;
-        if (selectedOption < 0) selectedOption = 4;
+        if (selectedOption < 0) selectedOption = 5;
     }
     else if (IsKeyPressed(KEY_S) || IsKeyPressed(KEY_DOWN))
     {
         selectedOption++;
-        if (selectedOption > 4) selectedOption = 0;
+        if (selectedOption > 5) selectedOption = 0;
     }
     
     // Selection
@@ -77,10 +91,13 @@ void MainMenuScene::Update()
             case 2: // AI vs AI
                 SceneManager::GetInstance().LoadScene(3);
                 break;
-            case 3: // Options (placeholder)
+            case 3: // Replays
+                SceneManager::GetInstance().LoadScene(4);
+                break;
+            case 4: // Options (placeholder)
                 // TODO: Implement options scene
                 break;
-            case 4: // Quit
+            case 5: // Quit
                 // Close the window - the game loop will exit
                 CloseWindow();
                 break;
@@ -121,6 +138,7 @@ void MainMenuScene::Draw() const
         "PLAYER vs PLAYER",
         "PLAYER vs AI",
         "AI vs AI",
+        "REPLAYS",
         "OPTIONS",
         "QUIT GAME"
     };
@@ -128,7 +146,7 @@ void MainMenuScene::Draw() const
     int startY = screenHeight / 2 - 80;
     int spacing = 50;
     
-    for (int i = 0; i < 5; i++)
+    for (int i = 0; i < 6; i++)
     {
         Color optionColor = (i == selectedOption) ? GREEN : LIGHTGRAY;
         int fontSize = OPTION_FONT_SIZE;
@@ -181,42 +199,3 @@ void MainMenuScene::OnUnload()
     backgroundGame.reset();
     backgroundGlobal.reset();
 }
-
-void MainMenuScene::UpdateBackgroundAI()
-{
-    if (!backgroundGame->running) return;
-    
-    // Update AI for player 1
-    Vector2 ai1Direction = backgroundGame->player1.GetAIDirection(
-        backgroundGame->food.position, 
-        backgroundGame->player2
-    );
-    
-    if (ai1Direction.x != 0 || ai1Direction.y != 0)
-    {
-        if ((ai1Direction.y == -1 && backgroundGame->player1.direction.y != 1) ||
-            (ai1Direction.y == 1 && backgroundGame->player1.direction.y != -1) ||
-            (ai1Direction.x == -1 && backgroundGame->player1.direction.x != 1) ||
-            (ai1Direction.x == 1 && backgroundGame->player1.direction.x != -1))
-        {
-            backgroundGame->player1.direction = ai1Direction;
-        }
-    }
-    
-    // Update AI for player 2
-    Vector2 ai2Direction = backgroundGame->player2.GetAIDirection(
-        backgroundGame->food.position, 
-        backgroundGame->player1
-    );
-    
-    if (ai2Direction.x != 0 || ai2Direction.y != 0)
-    {
-        if ((ai2Direction.y == -1 && backgroundGame->player2.direction.y != 1) ||
-            (ai2Direction.y == 1 && backgroundGame->player2.direction.y != -1) ||
-            (ai2Direction.x == -1 && backgroundGame->player2.direction.x != 1) ||
-            (ai2Direction.x == 1 && backgroundGame->player2.direction.x != -1))
-        {
-            backgroundGame->player2.direction = ai2Direction;
-        }
-    }
-}
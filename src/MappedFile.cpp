@@ -0,0 +1,34 @@
+#include "MappedFile.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const std::string& path)
+{
+    int descriptor = open(path.c_str(), O_RDONLY);
+    if (descriptor < 0)
+        return;
+    
+    struct stat info;
+    if (fstat(descriptor, &info) == 0 && info.st_size > 0)
+    {
+        void* mapping = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (mapping != MAP_FAILED)
+        {
+            data = static_cast<const uint8_t*>(mapping);
+            size = static_cast<size_t>(info.st_size);
+        }
+    }
+    
+    // The mapping stays valid after the descriptor is closed
+    close(descriptor);
+}
+
+MappedFile::~MappedFile()
+{
+    if (data != nullptr)
+    {
+        munmap(const_cast<uint8_t*>(data), size);
+    }
+}
@@ -0,0 +1,46 @@
+#include "Match.hpp"
+#include "GameState.hpp"
+
+MatchResult Match::PlayAIvsAI(uint64_t seed, int maxTicks, ReplayRecorder* replay)
+{
+    GameState game(seed);
+    game.player1.direction = {1, 0};
+    game.player2.direction = {-1, 0};
+    
+    MatchResult result{0, 0, 0, 0};
+    
+    if (replay != nullptr)
+    {
+        replay->Begin(seed, GameState::cellCount, GameState::tickInterval);
+    }
+    
+    while (result.ticks < maxTicks)
+    {
+        game.player1.Steer(game.player1.GetAIDirection(game.food.position, game.player2));
+        game.player2.Steer(game.player2.GetAIDirection(game.food.position, game.player1));
+        
+        if (replay != nullptr)
+        {
+            replay->RecordTick(game.player1.direction, game.player2.direction);
+        }
+        
+        // Scores are cleared when the round ends, so remember them first
+        int score1 = game.score;
+        int score2 = game.score2;
+        
+        TickEvents events = game.Step();
+        result.ticks++;
+        
+        if (events.gameOver)
+        {
+            result.winner = game.winner;
+            result.score1 = score1 + (events.player1Ate ? 1 : 0);
+            result.score2 = score2 + (events.player2Ate ? 1 : 0);
+            return result;
+        }
+    }
+    
+    result.score1 = game.score;
+    result.score2 = game.score2;
+    return result;
+}
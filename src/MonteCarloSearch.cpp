@@ -0,0 +1,304 @@
+#include "MonteCarloSearch.hpp"
+#include "Random.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <thread>
+
+using namespace std;
+
+namespace
+{
+    constexpr double EXPLORATION = 0.7;   // UCB1 constant, for rewards in [0, 1]
+    constexpr int MAX_PLAYOUT_TICKS = 60; // Unfinished playouts are scored by food eaten
+    constexpr double SCORE_REWARD = 0.1;  // Per food ahead at the playout cutoff
+    constexpr double MAX_CUTOFF_REWARD = 0.4;
+    constexpr uint32_t RANDOM_MOVE_ODDS = 4; // Playouts pick a random safe move 1 time in 4
+    
+    int Distance(Cell a, Cell b)
+    {
+        return abs(a.x - b.x) + abs(a.y - b.y);
+    }
+    
+    bool IsReverse(const Snake& snake, int move)
+    {
+        return DIRECTIONS[move].x == -snake.direction.x && DIRECTIONS[move].y == -snake.direction.y;
+    }
+    
+    // Into a wall or a body cell. Tails about to move count as occupied.
+    bool IsFatal(const GameState& state, const Snake& snake, int move)
+    {
+        Cell next = snake.body[0] + DIRECTIONS[move];
+        return !Bitboard::InBounds(next) || state.player1.Occupies(next) || state.player2.Occupies(next);
+    }
+    
+    // Player 1's reward for a finished round
+    double WinnerReward(int winner)
+    {
+        return winner == 1 ? 1.0 : winner == 2 ? 0.0 : 0.5;
+    }
+}
+
+// Tree node. Statistics are per snake and per move so each snake's choice
+// is made on its own; children are indexed by the joint move.
+struct MonteCarloNode
+{
+    int32_t children[16];   // move1 * 4 + move2, -1 = not expanded
+    uint32_t visits[2][4];  // [snake][move]
+    float reward[2][4];     // Summed rewards, from that snake's point of view
+    uint32_t total;
+};
+
+class MonteCarloSearch::Worker
+{
+    public:
+        Worker(MonteCarloSearch& owner, int nodeCapacity, uint64_t seed)
+            : owner(owner), rng(seed)
+        {
+            nodes.reserve(nodeCapacity);
+        }
+        
+        void Run(const GameState& root);
+        
+        // Root statistics of the last Run, for combining across threads
+        const MonteCarloNode& Root() const { return nodes[0]; }
+        int64_t Playouts() const { return playouts; }
+        
+    private:
+        int32_t NewNode();
+        int SelectMove(const MonteCarloNode& node, int side, const GameState& state, const Snake& snake) const;
+        int PlayoutMove(const GameState& state, const Snake& snake);
+        double Playout(GameState& state);
+        
+        MonteCarloSearch& owner;
+        Random rng;
+        std::vector<MonteCarloNode> nodes; // Arena: cleared, never freed, between searches
+        int64_t playouts = 0;
+};
+
+MonteCarloSearch::MonteCarloSearch(int threadCount, int nodesPerThread)
+{
+    if (threadCount <= 0)
+    {
+        threadCount = max(1u, thread::hardware_concurrency());
+    }
+    
+    uint64_t seed = Random::MakeSeed();
+    for (int i = 0; i < threadCount; i++)
+    {
+        workers.push_back(make_unique<Worker>(*this, nodesPerThread, seed + i));
+    }
+    
+    if (threadCount > 1)
+    {
+        helpers = make_unique<ThreadPool>(threadCount - 1);
+    }
+}
+
+MonteCarloSearch::~MonteCarloSearch() = default;
+
+MonteCarloResult MonteCarloSearch::Search(const GameState& state, int player, double timeBudget)
+{
+    deadline = Clock::now() + chrono::duration_cast<Clock::duration>(chrono::duration<double>(timeBudget));
+    
+    for (size_t i = 1; i < workers.size(); i++)
+    {
+        helpers->Submit([this, &state, i] { workers[i]->Run(state); });
+    }
+    
+    workers[0]->Run(state);
+    
+    if (helpers)
+    {
+        helpers->Wait();
+    }
+    
+    // Sum the root move statistics of every tree
+    int side = player - 1;
+    uint32_t visits[4] = {};
+    double reward[4] = {};
+    int64_t playouts = 0;
+    for (const auto& worker : workers)
+    {
+        for (int move = 0; move < 4; move++)
+        {
+            visits[move] += worker->Root().visits[side][move];
+            reward[move] += worker->Root().reward[side][move];
+        }
+        playouts += worker->Playouts();
+    }
+    
+    const Snake& snake = player == 1 ? state.player1 : state.player2;
+    MonteCarloResult result{snake.direction, 0.0, playouts};
+    uint32_t mostVisits = 0;
+    for (int move = 0; move < 4; move++)
+    {
+        if (visits[move] > mostVisits)
+        {
+            mostVisits = visits[move];
+            result.move = DIRECTIONS[move];
+            result.value = reward[move] / visits[move];
+        }
+    }
+    
+    return result;
+}
+
+void MonteCarloSearch::Worker::Run(const GameState& root)
+{
+    nodes.clear();
+    playouts = 0;
+    NewNode();
+    
+    struct Step
+    {
+        int32_t node;
+        int move1;
+        int move2;
+    };
+    Step path[MAX_PLAYOUT_TICKS];
+    
+    while (Clock::now() < owner.deadline)
+    {
+        GameState state = root;
+        int32_t current = 0;
+        int length = 0;
+        double reward = -1.0;
+        
+        // Walk down the tree, replaying the moves on the copy
+        while (length < MAX_PLAYOUT_TICKS)
+        {
+            int move1 = SelectMove(nodes[current], 0, state, state.player1);
+            int move2 = SelectMove(nodes[current], 1, state, state.player2);
+            path[length++] = Step{current, move1, move2};
+            
+            state.player1.direction = DIRECTIONS[move1];
+            state.player2.direction = DIRECTIONS[move2];
+            if (state.Step().gameOver)
+            {
+                reward = WinnerReward(state.winner);
+                break;
+            }
+            
+            int32_t child = nodes[current].children[move1 * 4 + move2];
+            if (child < 0)
+            {
+                // Expand one node per playout while the arena has room
+                if (nodes.size() < nodes.capacity())
+                {
+                    child = NewNode();
+                    nodes[current].children[move1 * 4 + move2] = child;
+                }
+                break;
+            }
+            current = child;
+        }
+        
+        if (reward < 0.0)
+        {
+            reward = Playout(state);
+        }
+        
+        for (int i = 0; i < length; i++)
+        {
+            MonteCarloNode& node = nodes[path[i].node];
+            node.total++;
+            node.visits[0][path[i].move1]++;
+            node.reward[0][path[i].move1] += static_cast<float>(reward);
+            node.visits[1][path[i].move2]++;
+            node.reward[1][path[i].move2] += static_cast<float>(1.0 - reward);
+        }
+        playouts++;
+    }
+}
+
+int32_t MonteCarloSearch::Worker::NewNode()
+{
+    MonteCarloNode node = {};
+    fill(begin(node.children), end(node.children), -1);
+    nodes.push_back(node);
+    return static_cast<int32_t>(nodes.size() - 1);
+}
+
+// UCB1 over this snake's own statistics; untried moves first, and moves
+// straight into a wall or body only when nothing else is left
+int MonteCarloSearch::Worker::SelectMove(const MonteCarloNode& node, int side, const GameState& state, const Snake& snake) const
+{
+    int best = -1;
+    double bestValue = -1.0;
+    bool bestFatal = true;
+    double logTotal = log(static_cast<double>(node.total) + 1.0);
+    
+    for (int move = 0; move < 4; move++)
+    {
+        if (IsReverse(snake, move))
+            continue;
+        
+        bool fatal = IsFatal(state, snake, move);
+        if (fatal && !bestFatal)
+            continue;
+        
+        uint32_t visits = node.visits[side][move];
+        double value = visits == 0 ? 2.0
+                     : node.reward[side][move] / visits + EXPLORATION * sqrt(logTotal / visits);
+        
+        if (best < 0 || (bestFatal && !fatal) || value > bestValue)
+        {
+            best = move;
+            bestValue = value;
+            bestFatal = fatal;
+        }
+    }
+    
+    return best;
+}
+
+// Default policy: a safe move, usually the one closest to the food
+int MonteCarloSearch::Worker::PlayoutMove(const GameState& state, const Snake& snake)
+{
+    int safe[4];
+    int safeCount = 0;
+    int closest = -1;
+    int closestDistance = 0;
+    
+    for (int move = 0; move < 4; move++)
+    {
+        if (IsReverse(snake, move) || IsFatal(state, snake, move))
+            continue;
+        
+        safe[safeCount++] = move;
+        int distance = Distance(snake.body[0] + DIRECTIONS[move], state.food.position);
+        if (closest < 0 || distance < closestDistance)
+        {
+            closest = move;
+            closestDistance = distance;
+        }
+    }
+    
+    if (safeCount == 0)
+        return -1;
+    if (rng.NextBelow(RANDOM_MOVE_ODDS) == 0)
+        return safe[rng.NextBelow(safeCount)];
+    return closest;
+}
+
+// Plays on from state and returns player 1's reward
+double MonteCarloSearch::Worker::Playout(GameState& state)
+{
+    for (int tick = 0; tick < MAX_PLAYOUT_TICKS; tick++)
+    {
+        // Trapped snakes keep going straight
+        int move1 = PlayoutMove(state, state.player1);
+        int move2 = PlayoutMove(state, state.player2);
+        if (move1 >= 0)
+            state.player1.direction = DIRECTIONS[move1];
+        if (move2 >= 0)
+            state.player2.direction = DIRECTIONS[move2];
+        
+        if (state.Step().gameOver)
+            return WinnerReward(state.winner);
+    }
+    
+    double lead = SCORE_REWARD * (state.score - state.score2);
+    return 0.5 + clamp(lead, -MAX_CUTOFF_REWARD, MAX_CUTOFF_REWARD);
+}
@@ -0,0 +1,88 @@
+#include "OpeningBook.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+using namespace std;
+
+namespace
+{
+    const char MAGIC[4] = {'S', 'N', 'O', 'B'};
+    constexpr uint32_t VERSION = 1;
+    
+    struct Header
+    {
+        char magic[4];
+        uint32_t version;
+        uint64_t count;
+    };
+    
+    static_assert(sizeof(Header) == 16 && sizeof(OpeningBook::Entry) == 16, "book layout changed");
+}
+
+OpeningBook::OpeningBook(const string& path)
+    : file(path)
+{
+    if (!file.IsOpen() || file.Size() < sizeof(Header))
+        return;
+    
+    Header header;
+    memcpy(&header, file.Data(), sizeof(Header));
+    if (memcmp(header.magic, MAGIC, 4) != 0 || header.version != VERSION ||
+        header.count != (file.Size() - sizeof(Header)) / sizeof(Entry))
+        return;
+    
+    // The mapping is page aligned, so entries after the 16-byte header are too
+    entries = reinterpret_cast<const Entry*>(file.Data() + sizeof(Header));
+    count = static_cast<size_t>(header.count);
+}
+
+bool OpeningBook::Probe(uint64_t hash, int player, Cell& move) const
+{
+    const Entry* last = entries + count;
+    const Entry* entry = lower_bound(entries, last, hash, [](const Entry& e, uint64_t key) { return e.hash < key; });
+    
+    if (entry == last || entry->hash != hash || entry->moves[player - 1] >= 4)
+        return false;
+    
+    move = DIRECTIONS[entry->moves[player - 1]];
+    return true;
+}
+
+bool OpeningBook::Write(const char* path, vector<Entry> entries)
+{
+    stable_sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.hash < b.hash; });
+    
+    // Keep the last of each run of equal hashes
+    vector<Entry> unique;
+    for (const Entry& entry : entries)
+    {
+        if (!unique.empty() && unique.back().hash == entry.hash)
+            unique.back() = entry;
+        else
+            unique.push_back(entry);
+    }
+    
+    FILE* file = fopen(path, "wb");
+    if (file == nullptr)
+        return false;
+    
+    Header header;
+    memcpy(header.magic, MAGIC, 4);
+    header.version = VERSION;
+    header.count = unique.size();
+    
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                   fwrite(unique.data(), sizeof(Entry), unique.size(), file) == unique.size();
+    return fclose(file) == 0 && written;
+}
+
+uint8_t OpeningBook::MoveCode(Cell direction)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        if (DIRECTIONS[i] == direction)
+            return static_cast<uint8_t>(i);
+    }
+    return noMove;
+}
@@ -0,0 +1,385 @@
+#include "PolicyNetwork.hpp"
+#include "Random.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace
+{
+    const char MAGIC[4] = {'S', 'N', 'P', 'N'};
+    constexpr uint32_t VERSION = 1;
+    constexpr int LANES = 8; // Floats per AVX2 register; strides are multiples of this
+    
+    // out[0, stride) = bias + the sum of the given rows of weights
+    void AccumulateRowsScalar(float* out, const float* bias, const float* weights, int stride,
+                              const int* rows, int rowCount)
+    {
+        copy(bias, bias + stride, out);
+        for (int k = 0; k < rowCount; k++)
+        {
+            const float* row = weights + size_t(rows[k]) * stride;
+            for (int o = 0; o < stride; o++)
+            {
+                out[o] += row[o];
+            }
+        }
+    }
+    
+    // out[0, stride) = bias + in[0, inputs) times weights. Fused multiply-adds
+    // in the same order as ForwardAvx2, so both round alike.
+    void ForwardScalar(float* out, const float* bias, const float* weights, int stride,
+                       const float* in, int inputs)
+    {
+        copy(bias, bias + stride, out);
+        for (int j = 0; j < inputs; j++)
+        {
+            const float* row = weights + size_t(j) * stride;
+            for (int o = 0; o < stride; o++)
+            {
+                out[o] = fma(in[j], row[o], out[o]);
+            }
+        }
+    }
+
+#if defined(__x86_64__) || defined(__i386__)
+    // As the scalar kernels, 32 outputs at a time in four registers so each
+    // accumulator stays in a register across all rows
+    __attribute__((target("avx2,fma")))
+    void AccumulateRowsAvx2(float* out, const float* bias, const float* weights, int stride,
+                            const int* rows, int rowCount)
+    {
+        int o = 0;
+        for (; o + 4 * LANES <= stride; o += 4 * LANES)
+        {
+            __m256 sum0 = _mm256_loadu_ps(bias + o);
+            __m256 sum1 = _mm256_loadu_ps(bias + o + LANES);
+            __m256 sum2 = _mm256_loadu_ps(bias + o + 2 * LANES);
+            __m256 sum3 = _mm256_loadu_ps(bias + o + 3 * LANES);
+            
+            for (int k = 0; k < rowCount; k++)
+            {
+                const float* row = weights + size_t(rows[k]) * stride + o;
+                sum0 = _mm256_add_ps(sum0, _mm256_loadu_ps(row));
+                sum1 = _mm256_add_ps(sum1, _mm256_loadu_ps(row + LANES));
+                sum2 = _mm256_add_ps(sum2, _mm256_loadu_ps(row + 2 * LANES));
+                sum3 = _mm256_add_ps(sum3, _mm256_loadu_ps(row + 3 * LANES));
+            }
+            
+            _mm256_storeu_ps(out + o, sum0);
+            _mm256_storeu_ps(out + o + LANES, sum1);
+            _mm256_storeu_ps(out + o + 2 * LANES, sum2);
+            _mm256_storeu_ps(out + o + 3 * LANES, sum3);
+        }
+        
+        for (; o < stride; o += LANES)
+        {
+            __m256 sum = _mm256_loadu_ps(bias + o);
+            for (int k = 0; k < rowCount; k++)
+            {
+                sum = _mm256_add_ps(sum, _mm256_loadu_ps(weights + size_t(rows[k]) * stride + o));
+            }
+            _mm256_storeu_ps(out + o, sum);
+        }
+    }
+    
+    __attribute__((target("avx2,fma")))
+    void ForwardAvx2(float* out, const float* bias, const float* weights, int stride,
+                     const float* in, int inputs)
+    {
+        int o = 0;
+        for (; o + 4 * LANES <= stride; o += 4 * LANES)
+        {
+            __m256 sum0 = _mm256_loadu_ps(bias + o);
+            __m256 sum1 = _mm256_loadu_ps(bias + o + LANES);
+            __m256 sum2 = _mm256_loadu_ps(bias + o + 2 * LANES);
+            __m256 sum3 = _mm256_loadu_ps(bias + o + 3 * LANES);
+            
+            for (int j = 0; j < inputs; j++)
+            {
+                const float* row = weights + size_t(j) * stride + o;
+                __m256 x = _mm256_set1_ps(in[j]);
+                sum0 = _mm256_fmadd_ps(x, _mm256_loadu_ps(row), sum0);
+                sum1 = _mm256_fmadd_ps(x, _mm256_loadu_ps(row + LANES), sum1);
+                sum2 = _mm256_fmadd_ps(x, _mm256_loadu_ps(row + 2 * LANES), sum2);
+                sum3 = _mm256_fmadd_ps(x, _mm256_loadu_ps(row + 3 * LANES), sum3);
+            }
+            
+            _mm256_storeu_ps(out + o, sum0);
+            _mm256_storeu_ps(out + o + LANES, sum1);
+            _mm256_storeu_ps(out + o + 2 * LANES, sum2);
+            _mm256_storeu_ps(out + o + 3 * LANES, sum3);
+        }
+        
+        for (; o < stride; o += LANES)
+        {
+            __m256 sum = _mm256_loadu_ps(bias + o);
+            for (int j = 0; j < inputs; j++)
+            {
+                sum = _mm256_fmadd_ps(_mm256_set1_ps(in[j]), _mm256_loadu_ps(weights + size_t(j) * stride + o), sum);
+            }
+            _mm256_storeu_ps(out + o, sum);
+        }
+    }
+#endif
+    
+    struct Kernels
+    {
+        void (*accumulateRows)(float*, const float*, const float*, int, const int*, int);
+        void (*forward)(float*, const float*, const float*, int, const float*, int);
+        const char* name;
+    };
+    
+    // Picked once, from what the CPU running the program supports
+    Kernels BestKernels()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        {
+            return Kernels{AccumulateRowsAvx2, ForwardAvx2, "avx2"};
+        }
+#endif
+        return Kernels{AccumulateRowsScalar, ForwardScalar, "scalar"};
+    }
+    
+    Kernels kernels = BestKernels();
+    
+    template <typename T>
+    bool ReadValues(FILE* file, T* values, size_t count)
+    {
+        return fread(values, sizeof(T), count, file) == count;
+    }
+    
+    template <typename T>
+    bool WriteValues(FILE* file, const T* values, size_t count)
+    {
+        return fwrite(values, sizeof(T), count, file) == count;
+    }
+}
+
+PolicyNetwork::Layer PolicyNetwork::MakeLayer(int inputs, int outputs)
+{
+    Layer layer;
+    layer.inputs = inputs;
+    layer.outputs = outputs;
+    layer.stride = (outputs + LANES - 1) / LANES * LANES;
+    layer.weights.assign(size_t(inputs) * layer.stride, 0.0f);
+    layer.bias.assign(layer.stride, 0.0f);
+    return layer;
+}
+
+bool PolicyNetwork::Load(const char* path)
+{
+    FILE* file = fopen(path, "rb");
+    if (file == nullptr)
+        return false;
+    
+    char magic[4];
+    uint32_t header[2]; // version, layer count
+    uint32_t widths[maxLayers + 1];
+    
+    bool valid = ReadValues(file, magic, 4) && memcmp(magic, MAGIC, 4) == 0 &&
+                 ReadValues(file, header, 2) && header[0] == VERSION &&
+                 header[1] >= 1 && header[1] <= uint32_t(maxLayers) &&
+                 ReadValues(file, widths, header[1] + 1) &&
+                 widths[0] == uint32_t(inputCount) && widths[header[1]] == uint32_t(outputCount);
+    
+    for (uint32_t i = 1; valid && i < header[1]; i++)
+    {
+        valid = widths[i] >= 1 && widths[i] <= uint32_t(maxWidth);
+    }
+    
+    PolicyNetwork loaded;
+    for (uint32_t l = 0; valid && l < header[1]; l++)
+    {
+        Layer layer = MakeLayer(widths[l], widths[l + 1]);
+        for (int j = 0; valid && j < layer.inputs; j++)
+        {
+            valid = ReadValues(file, &layer.weights[size_t(j) * layer.stride], layer.outputs);
+        }
+        valid = valid && ReadValues(file, layer.bias.data(), layer.outputs);
+        
+        loaded.widest = max(loaded.widest, layer.stride);
+        loaded.layers.push_back(move(layer));
+    }
+    
+    fclose(file);
+    if (valid)
+    {
+        *this = move(loaded);
+    }
+    return valid;
+}
+
+bool PolicyNetwork::Save(const char* path) const
+{
+    if (!IsLoaded())
+        return false;
+    
+    FILE* file = fopen(path, "wb");
+    if (file == nullptr)
+        return false;
+    
+    uint32_t header[2] = {VERSION, uint32_t(layers.size())};
+    bool written = WriteValues(file, MAGIC, 4) && WriteValues(file, header, 2);
+    
+    uint32_t firstWidth = inputCount;
+    written = written && WriteValues(file, &firstWidth, 1);
+    for (const Layer& layer : layers)
+    {
+        uint32_t width = layer.outputs;
+        written = written && WriteValues(file, &width, 1);
+    }
+    
+    for (const Layer& layer : layers)
+    {
+        for (int j = 0; written && j < layer.inputs; j++)
+        {
+            written = WriteValues(file, &layer.weights[size_t(j) * layer.stride], layer.outputs);
+        }
+        written = written && WriteValues(file, layer.bias.data(), layer.outputs);
+    }
+    
+    return fclose(file) == 0 && written;
+}
+
+void PolicyNetwork::Randomize(const vector<int>& hiddenWidths, uint64_t seed)
+{
+    Random rng(seed);
+    layers.clear();
+    widest = 0;
+    
+    int inputs = inputCount;
+    for (size_t l = 0; l <= hiddenWidths.size(); l++)
+    {
+        int outputs = l < hiddenWidths.size() ? hiddenWidths[l] : outputCount;
+        Layer layer = MakeLayer(inputs, outputs);
+        
+        float limit = sqrt(6.0f / inputs);
+        for (int j = 0; j < inputs; j++)
+        {
+            for (int o = 0; o < outputs; o++)
+            {
+                layer.weights[size_t(j) * layer.stride + o] = limit * (rng.Next() * (2.0f / 4294967296.0f) - 1.0f);
+            }
+        }
+        
+        widest = max(widest, layer.stride);
+        layers.push_back(move(layer));
+        inputs = outputs;
+    }
+}
+
+void PolicyNetwork::Evaluate(const uint64_t* observations, int batch, float* logits, Scratch& scratch) const
+{
+    // Activations of the whole batch, one widest-sized row per observation.
+    // Each layer runs over the batch before the next, so its weights are
+    // fetched into cache once per batch rather than once per observation.
+    size_t activations = size_t(batch) * widest;
+    if (scratch.current.size() < activations)
+    {
+        scratch.current.resize(activations);
+        scratch.next.resize(activations);
+    }
+    float* current = scratch.current.data();
+    float* next = scratch.next.data();
+    int rows[inputCount];
+    
+    const Layer& first = layers[0];
+    for (int b = 0; b < batch; b++)
+    {
+        const uint64_t* words = observations + size_t(b) * Observation::wordCount;
+        int rowCount = 0;
+        
+        for (int plane = 0; plane < Observation::planeCount; plane++)
+        {
+            for (int w = 0; w < Bitboard::wordCount; w++)
+            {
+                uint64_t bits = words[plane * Bitboard::wordCount + w];
+                while (bits != 0)
+                {
+                    rows[rowCount++] = plane * Bitboard::cellTotal + w * 64 + __builtin_ctzll(bits);
+                    bits &= bits - 1;
+                }
+            }
+        }
+        
+        kernels.accumulateRows(&current[size_t(b) * widest], first.bias.data(), first.weights.data(),
+                               first.stride, rows, rowCount);
+    }
+    
+    for (size_t l = 1; l < layers.size(); l++)
+    {
+        const Layer& layer = layers[l];
+        
+        for (size_t i = 0; i < activations; i++)
+        {
+            current[i] = max(current[i], 0.0f);
+        }
+        
+        for (int b = 0; b < batch; b++)
+        {
+            kernels.forward(&next[size_t(b) * widest], layer.bias.data(), layer.weights.data(), layer.stride,
+                            &current[size_t(b) * widest], layer.inputs);
+        }
+        swap(current, next);
+    }
+    
+    for (int b = 0; b < batch; b++)
+    {
+        copy_n(&current[size_t(b) * widest], outputCount, logits + size_t(b) * outputCount);
+    }
+}
+
+Cell PolicyNetwork::ChooseMove(const float* logits, const GameState& state, int player)
+{
+    const Snake& snake = player == 1 ? state.player1 : state.player2;
+    
+    int best = -1;
+    bool bestSafe = false;
+    for (int i = 0; i < outputCount; i++)
+    {
+        Cell direction = DIRECTIONS[i];
+        if (direction.x == -snake.direction.x && direction.y == -snake.direction.y)
+            continue;
+        
+        Cell next = snake.body[0] + direction;
+        bool safe = Bitboard::InBounds(next) && state.OwnerAt(next) == 0;
+        
+        if (best < 0 || (safe && !bestSafe) || (safe == bestSafe && logits[i] > logits[best]))
+        {
+            best = i;
+            bestSafe = safe;
+        }
+    }
+    
+    return DIRECTIONS[best];
+}
+
+const char* PolicyNetwork::KernelName()
+{
+    return kernels.name;
+}
+
+bool PolicyNetwork::UseKernels(const char* name)
+{
+    Kernels best = BestKernels();
+    if (strcmp(name, best.name) == 0)
+    {
+        kernels = best;
+        return true;
+    }
+    if (strcmp(name, "scalar") == 0)
+    {
+        kernels = Kernels{AccumulateRowsScalar, ForwardScalar, "scalar"};
+        return true;
+    }
+    return false;
+}
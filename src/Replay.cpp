@@ -0,0 +1,147 @@
+#include "Replay.hpp"
+#include <cmath>
+
+using namespace std;
+
+namespace
+{
+    constexpr uint8_t MAGIC[3] = {'S', 'N', 'K'};
+    constexpr uint8_t VERSION = 1;
+    constexpr size_t RESERVED_RUN_BYTES = 1024;
+}
+
+void Varint::Append(vector<uint8_t>& out, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+bool Varint::Read(const uint8_t*& cursor, const uint8_t* end, uint64_t& value)
+{
+    value = 0;
+    
+    for (int shift = 0; shift < 64 && cursor < end; shift += 7)
+    {
+        uint8_t byte = *cursor++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+int ReplayRecorder::DirectionCode(Cell direction)
+{
+    if (direction.y < 0) return 0;
+    if (direction.y > 0) return 1;
+    if (direction.x < 0) return 2;
+    return 3;
+}
+
+Cell ReplayRecorder::CodeDirection(int code)
+{
+    return DIRECTIONS[code & 3];
+}
+
+void ReplayRecorder::Begin(uint64_t seed, int cellCount, double tickInterval)
+{
+    header = ReplayHeader{cellCount, tickInterval, seed, 0, 0};
+    runs.clear();
+    runs.reserve(RESERVED_RUN_BYTES);
+    runDirections = 0;
+    runLength = 0;
+    recording = true;
+}
+
+void ReplayRecorder::RecordTick(Cell direction1, Cell direction2)
+{
+    if (!recording)
+        return;
+    
+    int directions = DirectionCode(direction1) | (DirectionCode(direction2) << 2);
+    
+    if (runLength > 0 && directions != runDirections)
+    {
+        FlushRun();
+    }
+    
+    runDirections = directions;
+    runLength++;
+    header.tickCount++;
+}
+
+vector<uint8_t> ReplayRecorder::Finish(int winner)
+{
+    FlushRun();
+    header.winner = winner;
+    recording = false;
+    
+    vector<uint8_t> out(begin(MAGIC), end(MAGIC));
+    out.push_back(VERSION);
+    out.push_back(static_cast<uint8_t>(header.cellCount));
+    Varint::Append(out, static_cast<uint64_t>(llround(header.tickInterval * 1e6)));
+    Varint::Append(out, header.seed);
+    Varint::Append(out, static_cast<uint64_t>(header.tickCount));
+    Varint::Append(out, static_cast<uint64_t>(header.winner));
+    out.insert(out.end(), runs.begin(), runs.end());
+    return out;
+}
+
+void ReplayRecorder::FlushRun()
+{
+    if (runLength == 0)
+        return;
+    
+    Varint::Append(runs, (runLength << 4) | static_cast<uint64_t>(runDirections));
+    runLength = 0;
+}
+
+ReplayReader::ReplayReader(const uint8_t* data, size_t size)
+    : cursor(data),
+      end(data + size)
+{
+    if (size < 5 || data[0] != MAGIC[0] || data[1] != MAGIC[1] || data[2] != MAGIC[2] || data[3] != VERSION)
+        return;
+    
+    header.cellCount = data[4];
+    cursor = data + 5;
+    
+    uint64_t intervalMicros, seed, tickCount, winner;
+    if (!Varint::Read(cursor, end, intervalMicros) || !Varint::Read(cursor, end, seed) ||
+        !Varint::Read(cursor, end, tickCount) || !Varint::Read(cursor, end, winner))
+        return;
+    
+    header.tickInterval = intervalMicros / 1e6;
+    header.seed = seed;
+    header.tickCount = static_cast<int>(tickCount);
+    header.winner = static_cast<int>(winner);
+    valid = true;
+}
+
+bool ReplayReader::NextTick(Cell& direction1, Cell& direction2)
+{
+    if (!valid || ticksRead >= header.tickCount)
+        return false;
+    
+    if (runRemaining == 0)
+    {
+        uint64_t run;
+        if (!Varint::Read(cursor, end, run) || (run >> 4) == 0)
+        {
+            valid = false;
+            return false;
+        }
+        runDirections = static_cast<int>(run & 0xF);
+        runRemaining = run >> 4;
+    }
+    
+    direction1 = ReplayRecorder::CodeDirection(runDirections);
+    direction2 = ReplayRecorder::CodeDirection(runDirections >> 2);
+    runRemaining--;
+    ticksRead++;
+    return true;
+}
@@ -0,0 +1,30 @@
+#include "ReplayLog.hpp"
+
+ReplayLog::ReplayLog(const std::string& path)
+    : file(path)
+{
+    if (!file.IsOpen())
+        return;
+    
+    const uint8_t* start = file.Data();
+    const uint8_t* cursor = start;
+    const uint8_t* end = start + file.Size();
+    
+    while (cursor < end)
+    {
+        uint64_t size;
+        
+        // Stop at a truncated tail (e.g. the game is still writing)
+        if (!Varint::Read(cursor, end, size) || size > static_cast<uint64_t>(end - cursor))
+            break;
+        
+        records.push_back(Record{static_cast<size_t>(cursor - start), static_cast<size_t>(size)});
+        cursor += size;
+    }
+}
+
+ReplayReader ReplayLog::Open(int index) const
+{
+    const Record& record = records[index];
+    return ReplayReader(file.Data() + record.offset, record.size);
+}
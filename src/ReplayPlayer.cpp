@@ -0,0 +1,72 @@
+#include "ReplayPlayer.hpp"
+#include <algorithm>
+
+using namespace std;
+
+ReplayPlayer::ReplayPlayer(ReplayReader reader)
+    : header(reader.Header()),
+      state(reader.Header().seed),
+      tick(0)
+{
+    Cell direction1, direction2;
+    while (reader.NextTick(direction1, direction2))
+    {
+        moves.push_back(static_cast<uint8_t>(ReplayRecorder::DirectionCode(direction1) |
+                                             (ReplayRecorder::DirectionCode(direction2) << 2)));
+    }
+    
+    // One pass over the match to lay down the keyframes
+    keyframes.reserve(moves.size() / keyframeInterval + 1);
+    for (int i = 0; i < TickCount(); i++)
+    {
+        if (i % keyframeInterval == 0)
+        {
+            keyframes.push_back(state.Save());
+        }
+        ApplyMove(i);
+    }
+    
+    if (keyframes.empty())
+    {
+        keyframes.push_back(state.Save());
+    }
+    
+    state.Restore(keyframes[0]);
+}
+
+void ReplayPlayer::Seek(int targetTick)
+{
+    targetTick = clamp(targetTick, 0, TickCount());
+    
+    // Moving forward within the same keyframe span: keep simulating from here
+    int keyframe = targetTick / keyframeInterval;
+    if (!(targetTick >= tick && tick / keyframeInterval == keyframe))
+    {
+        keyframe = min(keyframe, static_cast<int>(keyframes.size()) - 1);
+        state.Restore(keyframes[keyframe]);
+        tick = keyframe * keyframeInterval;
+    }
+    
+    while (tick < targetTick)
+    {
+        ApplyMove(tick);
+        tick++;
+    }
+}
+
+void ReplayPlayer::StepForward()
+{
+    if (tick < TickCount())
+    {
+        ApplyMove(tick);
+        tick++;
+    }
+}
+
+void ReplayPlayer::ApplyMove(int moveTick)
+{
+    uint8_t code = moves[moveTick];
+    state.player1.direction = ReplayRecorder::CodeDirection(code);
+    state.player2.direction = ReplayRecorder::CodeDirection(code >> 2);
+    state.Step();
+}
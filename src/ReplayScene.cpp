@@ -0,0 +1,313 @@
+#include "ReplayScene.hpp"
+#include "SceneManager.hpp"
+#include "raylib.h"
+#include <algorithm>
+
+using namespace std;
+
+namespace
+{
+    constexpr int BORDER_PADDING = 5;
+    constexpr int TITLE_FONT_SIZE = 40;
+    constexpr int TITLE_Y_POSITION = 20;
+    constexpr int INFO_FONT_SIZE = 20;
+    constexpr int PAGE_TICKS = 50;
+}
+
+ReplayScene::ReplayScene()
+    : Scene("Replay", 4),
+      clock(GameState::tickInterval, GetTime),
+      selectedReplay(0),
+      paused(false)
+{
+}
+
+void ReplayScene::OnLoad()
+{
+    game = std::make_unique<Game>(false);
+    global = std::make_unique<Global>();
+    
+    // Map the log as it is now; rounds finished later show up next visit
+    log = std::make_unique<ReplayLog>(ReplayLog::defaultPath);
+    player.reset();
+    paused = false;
+    
+    if (log->Count() > 0)
+    {
+        // Newest round first
+        OpenReplay(log->Count() - 1);
+    }
+}
+
+void ReplayScene::OpenReplay(int index)
+{
+    ReplayReader reader = log->Open(index);
+    
+    // Skip records this build cannot replay (other board size, bad data)
+    if (!reader.IsValid() || reader.Header().cellCount != GameState::cellCount)
+    {
+        player.reset();
+        selectedReplay = index;
+        return;
+    }
+    
+    player = std::make_unique<ReplayPlayer>(reader);
+    selectedReplay = index;
+    clock.interval = player->Header().tickInterval;
+    clock.Restart();
+    SeekTo(0);
+}
+
+void ReplayScene::SeekTo(int tick)
+{
+    player->Seek(clamp(tick, 0, LastTick()));
+    game->Restore(player->State());
+}
+
+int ReplayScene::LastTick() const
+{
+    // The deciding tick resets the board, so stop on the frame before it
+    if (player->Header().winner != 0)
+    {
+        return max(player->TickCount() - 1, 0);
+    }
+    return player->TickCount();
+}
+
+void ReplayScene::Update()
+{
+    if (IsKeyPressed(KEY_ESCAPE))
+    {
+        SceneManager::GetInstance().LoadScene(0); // Main menu
+        return;
+    }
+    
+    if (log->Count() == 0)
+    {
+        return;
+    }
+    
+    // Match selection
+    if (IsKeyPressed(KEY_UP) || IsKeyPressed(KEY_W))
+    {
+        OpenReplay(selectedReplay > 0 ? selectedReplay - 1 : log->Count() - 1);
+    }
+    else if (IsKeyPressed(KEY_DOWN) || IsKeyPressed(KEY_S))
+    {
+        OpenReplay(selectedReplay < log->Count() - 1 ? selectedReplay + 1 : 0);
+    }
+    
+    if (!player)
+    {
+        return;
+    }
+    
+    int tick = player->CurrentTick();
+    
+    // Transport controls
+    if (IsKeyPressed(KEY_SPACE))
+    {
+        if (paused && tick >= LastTick())
+        {
+            SeekTo(0);
+        }
+        paused = !paused;
+        clock.Restart();
+    }
+    else if (IsKeyPressed(KEY_RIGHT) || IsKeyPressed(KEY_D))
+    {
+        paused = true;
+        SeekTo(tick + 1);
+    }
+    else if (IsKeyPressed(KEY_LEFT) || IsKeyPressed(KEY_A))
+    {
+        paused = true;
+        SeekTo(tick - 1);
+    }
+    else if (IsKeyPressed(KEY_PAGE_UP))
+    {
+        SeekTo(tick + PAGE_TICKS);
+    }
+    else if (IsKeyPressed(KEY_PAGE_DOWN))
+    {
+        SeekTo(tick - PAGE_TICKS);
+    }
+    else if (IsKeyPressed(KEY_HOME))
+    {
+        SeekTo(0);
+    }
+    else if (IsKeyPressed(KEY_END))
+    {
+        SeekTo(LastTick());
+    }
+    
+    if (paused)
+    {
+        return;
+    }
+    
+    // Play back at the recorded tick rate
+    int ticksDue = clock.Advance();
+    if (ticksDue > 0)
+    {
+        SeekTo(player->CurrentTick() + ticksDue);
+    }
+    
+    if (player->CurrentTick() >= LastTick())
+    {
+        paused = true;
+    }
+}
+
+void ReplayScene::Draw() const
+{
+    BeginDrawing();
+    ClearBackground(global->backgroundColor);
+    
+    if (!player)
+    {
+        DrawEmptyScreen();
+    }
+    else
+    {
+        DrawUI();
+        game->Draw();
+    }
+    
+    EndDrawing();
+}
+
+void ReplayScene::DrawUI() const
+{
+    const float borderX = static_cast<float>(Game::borderSize - BORDER_PADDING);
+    const float borderY = static_cast<float>(Game::borderSize - BORDER_PADDING);
+    const float borderWidth = static_cast<float>(Game::cellSize * Game::cellCount + 2 * BORDER_PADDING);
+    const float borderHeight = static_cast<float>(Game::cellSize * Game::cellCount + 2 * BORDER_PADDING);
+    
+    DrawRectangleLinesEx(
+        Rectangle{borderX, borderY, borderWidth, borderHeight}, 
+        BORDER_PADDING, 
+        Global::snakeColor
+    );
+    
+    DrawText(
+        TextFormat("Replay %i / %i", selectedReplay + 1, log->Count()), 
+        Game::borderSize - BORDER_PADDING, 
+        TITLE_Y_POSITION, 
+        TITLE_FONT_SIZE, 
+        global->snakeColor
+    );
+    
+    DrawText(
+        TextFormat("Tick %i / %i%s", player->CurrentTick(), LastTick(), paused ? "  (paused)" : ""), 
+        Game::borderSize + 380, 
+        TITLE_Y_POSITION + 12, 
+        INFO_FONT_SIZE, 
+        LIGHTGRAY
+    );
+    
+    const int scoreY = Game::borderSize + Game::cellSize * Game::cellCount + BORDER_PADDING * 2;
+    DrawText(
+        TextFormat("P1: %i", game->score), 
+        Game::borderSize - BORDER_PADDING, 
+        scoreY, 
+        TITLE_FONT_SIZE, 
+        global->snakeColor
+    );
+    
+    DrawText(
+        TextFormat("P2: %i", game->score2), 
+        Game::borderSize + 320, 
+        scoreY, 
+        TITLE_FONT_SIZE, 
+        RED
+    );
+    
+    // Result banner once the deciding tick is reached
+    if (player->CurrentTick() >= LastTick())
+    {
+        const char* resultText;
+        Color resultColor;
+        
+        switch (player->Header().winner)
+        {
+            case 1:
+                resultText = "GREEN WINS";
+                resultColor = Global::snakeColor;
+                break;
+            case 2:
+                resultText = "RED WINS";
+                resultColor = RED;
+                break;
+            case 3:
+                resultText = "TIE GAME";
+                resultColor = YELLOW;
+                break;
+            default:
+                resultText = "ROUND ABANDONED";
+                resultColor = GRAY;
+                break;
+        }
+        
+        int resultWidth = MeasureText(resultText, TITLE_FONT_SIZE);
+        DrawText(
+            resultText,
+            (GetScreenWidth() - resultWidth) / 2,
+            GetScreenHeight() / 2 - TITLE_FONT_SIZE / 2,
+            TITLE_FONT_SIZE,
+            resultColor
+        );
+    }
+    
+    DrawText(
+        "SPACE play/pause  LEFT/RIGHT step  PGUP/PGDN seek  UP/DOWN match  ESC menu",
+        Game::borderSize - BORDER_PADDING,
+        GetScreenHeight() - 25,
+        16,
+        GRAY
+    );
+}
+
+void ReplayScene::DrawEmptyScreen() const
+{
+    int screenWidth = GetScreenWidth();
+    int screenHeight = GetScreenHeight();
+    
+    const char* title = log->Count() == 0 ? "NO REPLAYS YET" : "REPLAY UNREADABLE";
+    int titleWidth = MeasureText(title, 50);
+    DrawText(
+        title,
+        (screenWidth - titleWidth) / 2,
+        screenHeight / 3,
+        50,
+        RAYWHITE
+    );
+    
+    const char* hint = log->Count() == 0 ? TextFormat("Finished rounds are saved to %s", ReplayLog::defaultPath)
+                                         : "Press UP/DOWN to pick another round";
+    int hintWidth = MeasureText(hint, 24);
+    DrawText(
+        hint,
+        (screenWidth - hintWidth) / 2,
+        screenHeight / 2,
+        24,
+        LIGHTGRAY
+    );
+    
+    DrawText(
+        "Press ESC to return to menu",
+        screenWidth / 2 - 150,
+        screenHeight - 150,
+        20,
+        GRAY
+    );
+}
+
+void ReplayScene::OnUnload()
+{
+    // Unmap the log; the next visit maps it again with any new rounds
+    player.reset();
+    log.reset();
+    game.reset();
+    global.reset();
+}
@@ -0,0 +1,75 @@
+#include "ReplayWriter.hpp"
+#include "Replay.hpp"
+#include <cstdio>
+
+using namespace std;
+
+ReplayWriter::ReplayWriter(const string& path)
+    : path(path),
+      writer(&ReplayWriter::WriterLoop, this)
+{
+}
+
+ReplayWriter::~ReplayWriter()
+{
+    {
+        lock_guard<mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueChanged.notify_one();
+    writer.join();
+}
+
+void ReplayWriter::Submit(vector<uint8_t> replay)
+{
+    {
+        lock_guard<mutex> lock(queueMutex);
+        queue.push_back(move(replay));
+    }
+    queueChanged.notify_one();
+}
+
+void ReplayWriter::WriterLoop()
+{
+    FILE* file = fopen(path.c_str(), "ab");
+    if (file == nullptr)
+    {
+        fprintf(stderr, "ReplayWriter: cannot open %s, replays will be dropped\n", path.c_str());
+    }
+    
+    vector<uint8_t> buffer;
+    
+    while (true)
+    {
+        deque<vector<uint8_t>> batch;
+        bool done;
+        {
+            unique_lock<mutex> lock(queueMutex);
+            queueChanged.wait(lock, [this] { return stopping || !queue.empty(); });
+            batch.swap(queue);
+            done = stopping;
+        }
+        
+        // Coalesce everything queued into one write
+        buffer.clear();
+        for (const auto& replay : batch)
+        {
+            Varint::Append(buffer, replay.size());
+            buffer.insert(buffer.end(), replay.begin(), replay.end());
+        }
+        
+        if (file != nullptr && !buffer.empty())
+        {
+            fwrite(buffer.data(), 1, buffer.size(), file);
+            fflush(file);
+        }
+        
+        if (done)
+            break;
+    }
+    
+    if (file != nullptr)
+    {
+        fclose(file);
+    }
+}
@@ -0,0 +1,54 @@
+#include "SimClock.hpp"
+#include <chrono>
+#include <cmath>
+
+using namespace std;
+
+namespace
+{
+    constexpr int MAX_CATCH_UP_TICKS = 5;
+}
+
+SimClock::SimClock(double interval, TimeSource timeSource)
+    : interval(interval),
+      maxCatchUpTicks(MAX_CATCH_UP_TICKS),
+      timeSource(move(timeSource)),
+      lastTime(0.0),
+      accumulator(0.0)
+{
+    Restart();
+}
+
+int SimClock::Advance()
+{
+    double currentTime = timeSource();
+    accumulator += currentTime - lastTime;
+    lastTime = currentTime;
+    
+    int ticks = 0;
+    while (accumulator >= interval && ticks < maxCatchUpTicks)
+    {
+        accumulator -= interval;
+        ticks++;
+    }
+    
+    // Too far behind (e.g. window dragged) - drop the backlog, keep the phase
+    if (accumulator >= interval)
+    {
+        accumulator = fmod(accumulator, interval);
+    }
+    
+    return ticks;
+}
+
+void SimClock::Restart()
+{
+    lastTime = timeSource();
+    accumulator = 0.0;
+}
+
+double SimClock::SteadyTime()
+{
+    using namespace chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
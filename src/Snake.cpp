@@ -1,131 +1,134 @@
 #include "Snake.hpp"
-#include "raylib.h"
-#include "raymath.h"
+#include <cstdlib>
 
 using namespace std;
 
 Snake::Snake()
-    : body{{Vector2{6, 9}, Vector2{5, 9}, Vector2{4, 9}}},
-      direction{1, 0},
-      addSegment{false},
-      initialPosition{6, 9},
-      initialDirection{1, 0}
+    : Snake(Cell{6, 9}, Cell{1, 0})
 {
 }
 
-Snake::Snake(Vector2 startPos, Vector2 startDirection)
-    : body{{startPos, Vector2{startPos.x - startDirection.x, startPos.y - startDirection.y}, 
-            Vector2{startPos.x - 2 * startDirection.x, startPos.y - 2 * startDirection.y}}},
-      direction{startDirection},
-      addSegment{false},
+Snake::Snake(Cell startPos, Cell startDirection)
+    : addSegment{false},
       initialPosition{startPos},
       initialDirection{startDirection}
 {
-}
-
-void Snake::Draw(int cellSize, int borderSize, Color snakeColor) const
-{
-    for (unsigned int i = 0; i < body.size(); i++)
-    {
-        float x = body[i].x;
-        float y = body[i].y;
-        Rectangle segment = Rectangle{
-            (borderSize + x * cellSize), 
-            (borderSize + y * cellSize), 
-            (float)cellSize, 
-            (float)cellSize
-        };
-        DrawRectangleRounded(segment, 0.5, 6, snakeColor);
-    }
+    PlaceAt(startPos, startDirection);
 }
 
 void Snake::Update()
 {
-    body.push_front(Vector2Add(body[0], direction));
+    Cell oldHead = body[0];
+    Cell newHead = oldHead + direction;
     
+    // Vacate the tail first so moving into the cell it just left is not a hit
     if (addSegment)
     {
         addSegment = false;
     }
     else
     {
+        Cell oldTail = body.back();
+        if (occupancy.Test(oldTail))
+        {
+            occupancy.Reset(oldTail);
+            hash ^= Zobrist::Body(oldTail);
+        }
         body.pop_back();
+        hash ^= Zobrist::Tail(oldTail) ^ Zobrist::Tail(body.back());
+    }
+    
+    hitSelf = occupancy.Test(newHead);
+    body.push_front(newHead);
+    hash ^= Zobrist::Head(oldHead) ^ Zobrist::Head(newHead);
+    
+    if (Bitboard::InBounds(newHead) && !hitSelf)
+    {
+        occupancy.Set(newHead);
+        hash ^= Zobrist::Body(newHead);
     }
 }
 
-void Snake::Reset(Music& music)
+void Snake::Reset()
 {
-    SeekMusicStream(music, 0.0f);
-    
-    body = {Vector2{initialPosition.x, initialPosition.y}, 
-            Vector2{initialPosition.x - initialDirection.x, initialPosition.y - initialDirection.y}, 
-            Vector2{initialPosition.x - 2 * initialDirection.x, initialPosition.y - 2 * initialDirection.y}};
-    direction = initialDirection;
+    PlaceAt(initialPosition, initialDirection);
 }
 
-void Snake::ResetWithPosition(Music& music, Vector2 startPos, Vector2 startDirection)
+void Snake::ResetWithPosition(Cell startPos, Cell startDirection)
 {
-    SeekMusicStream(music, 0.0f);
-    
     initialPosition = startPos;
     initialDirection = startDirection;
     
-    body = {Vector2{startPos.x, startPos.y}, 
-            Vector2{startPos.x - startDirection.x, startPos.y - startDirection.y}, 
-            Vector2{startPos.x - 2 * startDirection.x, startPos.y - 2 * startDirection.y}};
+    PlaceAt(startPos, startDirection);
+}
+
+void Snake::PlaceAt(Cell startPos, Cell startDirection)
+{
+    body.clear();
+    body.push_back(startPos);
+    body.push_back(Cell{startPos.x - startDirection.x, startPos.y - startDirection.y});
+    body.push_back(Cell{startPos.x - 2 * startDirection.x, startPos.y - 2 * startDirection.y});
     direction = startDirection;
+    addSegment = false;
+    hitSelf = false;
+    
+    occupancy.Clear();
+    hash = Zobrist::Head(body.front()) ^ Zobrist::Tail(body.back());
+    
+    for (Cell segment : body)
+    {
+        if (Bitboard::InBounds(segment) && !occupancy.Test(segment))
+        {
+            occupancy.Set(segment);
+            hash ^= Zobrist::Body(segment);
+        }
+    }
 }
 
-Vector2 Snake::GetAIDirection(Vector2 foodPos, const Snake& opponent) const
+void Snake::Steer(Cell newDirection)
 {
-    Vector2 head = body[0];
+    // Ignore "no move" and reversing into the neck
+    if (newDirection.x == 0 && newDirection.y == 0)
+        return;
+    if (newDirection.x == -direction.x && newDirection.y == -direction.y)
+        return;
+    
+    direction = newDirection;
+}
+
+Cell Snake::GetAIDirection(Cell foodPos, const Snake& opponent) const
+{
+    Cell head = body[0];
     
     // Calculate Manhattan distance for each direction
-    auto getManhattanDistance = [](Vector2 from, Vector2 to) -> float {
+    auto getManhattanDistance = [](Cell from, Cell to) -> int {
         return abs(from.x - to.x) + abs(from.y - to.y);
     };
     
     // Check if position is valid (not hitting walls or snakes)
-    auto isValidPosition = [&](Vector2 pos) -> bool {
-        // Check walls (assuming 25x25 grid)
-        if (pos.x < 0 || pos.x >= 25 || pos.y < 0 || pos.y >= 25)
+    auto isValidPosition = [&](Cell pos) -> bool {
+        // Check walls
+        if (!Bitboard::InBounds(pos))
             return false;
         
-        // Check collision with self
-        for (const auto& segment : body)
-            if (Vector2Equals(segment, pos))
-                return false;
-        
-        // Check collision with opponent
-        for (const auto& segment : opponent.body)
-            if (Vector2Equals(segment, pos))
-                return false;
-        
-        return true;
-    };
-    
-    // Possible directions
-    Vector2 directions[] = {
-        {0, -1},  // Up
-        {0, 1},   // Down
-        {-1, 0},  // Left
-        {1, 0}    // Right
+        // Check collision with self and opponent
+        return !Occupies(pos) && !opponent.Occupies(pos);
     };
     
-    Vector2 bestDirection = {0, 0};
-    float bestDistance = 1000000.0f;
+    Cell bestDirection = {0, 0};
+    int bestDistance = 1000000;
     
-    for (const auto& dir : directions)
+    for (const auto& dir : DIRECTIONS)
     {
         // Don't reverse direction
         if (dir.x == -direction.x && dir.y == -direction.y)
             continue;
         
-        Vector2 newPos = Vector2Add(head, dir);
+        Cell newPos = head + dir;
         
         if (isValidPosition(newPos))
         {
-            float distance = getManhattanDistance(newPos, foodPos);
+            int distance = getManhattanDistance(newPos, foodPos);
             if (distance < bestDistance)
             {
                 bestDistance = distance;
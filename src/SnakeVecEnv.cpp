@@ -0,0 +1,200 @@
+#include "snake_vec_env.h"
+#include "GameState.hpp"
+#include "Observation.hpp"
+#include "ThreadPool.hpp"
+#include <exception>
+#include <memory>
+#include <vector>
+
+using namespace std;
+
+static_assert(SNAKE_VEC_ENV_BOARD_SIZE == Bitboard::cellCount, "board size mismatch");
+static_assert(SNAKE_VEC_ENV_PLANES == Observation::planeCount, "plane count mismatch");
+static_assert(SNAKE_VEC_ENV_PLANE_WORDS == Bitboard::wordCount, "plane size mismatch");
+static_assert(SNAKE_VEC_ENV_AGENT_WORDS == Observation::wordCount, "observation size mismatch");
+
+namespace
+{
+    // Environments per pool task; below this a step runs on the calling thread
+    constexpr int ENVS_PER_TASK = 256;
+    
+    // Both snakes' views of one game: [2][Observation::wordCount]
+    void WriteObservation(const GameState& game, uint64_t* out)
+    {
+        Observation::Write(game, 1, out);
+        Observation::Write(game, 2, out + Observation::wordCount);
+    }
+}
+
+struct SnakeVecEnv
+{
+    SnakeVecEnv(int count, uint64_t seed);
+    
+    void StartRound(int index);
+    void StepRange(int begin, int end, const uint8_t* actions, uint64_t* observations,
+                   float* rewards, uint8_t* dones);
+    
+    // Runs body(begin, end) over chunks of environments, on the pool when it pays
+    template <typename Body>
+    void ForEachChunk(Body body);
+    
+    int count;
+    uint64_t baseSeed;
+    vector<GameState> games;
+    vector<uint64_t> rounds; // rounds started per environment, for fresh seeds
+    vector<int> ticks; // ticks into the current round
+    unique_ptr<ThreadPool> pool;
+};
+
+SnakeVecEnv::SnakeVecEnv(int count, uint64_t seed)
+    : count(count),
+      baseSeed(seed),
+      games(count, GameState(seed)),
+      rounds(count, 0),
+      ticks(count, 0)
+{
+    for (int i = 0; i < count; i++)
+    {
+        StartRound(i);
+    }
+    
+    if (count > ENVS_PER_TASK)
+    {
+        pool = make_unique<ThreadPool>();
+    }
+}
+
+void SnakeVecEnv::StartRound(int index)
+{
+    // Round r of environment i is seeded seed + i + r * count, so no two rounds share a seed
+    GameState& game = games[index];
+    game.NewRound(baseSeed + index + rounds[index] * count);
+    game.running = true;
+    game.player1.direction = {1, 0};
+    game.player2.direction = {-1, 0};
+    rounds[index]++;
+    ticks[index] = 0;
+}
+
+template <typename Body>
+void SnakeVecEnv::ForEachChunk(Body body)
+{
+    if (pool == nullptr)
+    {
+        body(0, count);
+        return;
+    }
+    
+    for (int begin = 0; begin < count; begin += ENVS_PER_TASK)
+    {
+        int end = min(begin + ENVS_PER_TASK, count);
+        pool->Submit([=] { body(begin, end); });
+    }
+    pool->Wait();
+}
+
+void SnakeVecEnv::StepRange(int begin, int end, const uint8_t* actions, uint64_t* observations,
+                            float* rewards, uint8_t* dones)
+{
+    for (int i = begin; i < end; i++)
+    {
+        GameState& game = games[i];
+        
+        if (actions != nullptr)
+        {
+            uint8_t action1 = actions[2 * i];
+            uint8_t action2 = actions[2 * i + 1];
+            if (action1 < 4)
+                game.player1.Steer(DIRECTIONS[action1]);
+            if (action2 < 4)
+                game.player2.Steer(DIRECTIONS[action2]);
+        }
+        
+        TickEvents events = game.Step();
+        ticks[i]++;
+        
+        float reward1 = events.player1Ate ? SNAKE_VEC_ENV_FOOD_REWARD : 0.0f;
+        float reward2 = events.player2Ate ? SNAKE_VEC_ENV_FOOD_REWARD : 0.0f;
+        bool done = events.gameOver || ticks[i] >= SNAKE_VEC_ENV_MAX_TICKS;
+        
+        if (events.gameOver)
+        {
+            if (game.winner == 1)
+            {
+                reward1 += 1.0f;
+                reward2 -= 1.0f;
+            }
+            else if (game.winner == 2)
+            {
+                reward1 -= 1.0f;
+                reward2 += 1.0f;
+            }
+        }
+        
+        if (done)
+        {
+            StartRound(i);
+        }
+        
+        if (rewards != nullptr)
+        {
+            rewards[2 * i] = reward1;
+            rewards[2 * i + 1] = reward2;
+        }
+        if (dones != nullptr)
+        {
+            dones[i] = done ? 1 : 0;
+        }
+        if (observations != nullptr)
+        {
+            WriteObservation(game, observations + size_t(i) * 2 * SNAKE_VEC_ENV_AGENT_WORDS);
+        }
+    }
+}
+
+extern "C" SnakeVecEnv* snake_vec_env_create(int num_envs, uint64_t seed)
+{
+    if (num_envs <= 0)
+        return nullptr;
+    
+    try
+    {
+        return new SnakeVecEnv(num_envs, seed);
+    }
+    catch (const exception&)
+    {
+        return nullptr;
+    }
+}
+
+extern "C" void snake_vec_env_destroy(SnakeVecEnv* env)
+{
+    delete env;
+}
+
+extern "C" int snake_vec_env_num_envs(const SnakeVecEnv* env)
+{
+    return env->count;
+}
+
+extern "C" void snake_vec_env_reset(SnakeVecEnv* env, uint64_t* observations)
+{
+    env->ForEachChunk([env, observations](int begin, int end) {
+        for (int i = begin; i < end; i++)
+        {
+            env->StartRound(i);
+            if (observations != nullptr)
+            {
+                WriteObservation(env->games[i], observations + size_t(i) * 2 * SNAKE_VEC_ENV_AGENT_WORDS);
+            }
+        }
+    });
+}
+
+extern "C" void snake_vec_env_step(SnakeVecEnv* env, const uint8_t* actions, uint64_t* observations,
+                                   float* rewards, uint8_t* dones)
+{
+    env->ForEachChunk([=](int begin, int end) {
+        env->StepRange(begin, end, actions, observations, rewards, dones);
+    });
+}
@@ -0,0 +1,139 @@
+#include "ThreadPool.hpp"
+
+using namespace std;
+
+namespace
+{
+    // Index of the pool worker running on this thread, or -1 for outside threads
+    thread_local int currentWorker = -1;
+    thread_local const void* currentPool = nullptr;
+}
+
+ThreadPool::ThreadPool(int threadCount)
+{
+    if (threadCount <= 0)
+    {
+        threadCount = max(1u, thread::hardware_concurrency());
+    }
+    
+    for (int i = 0; i < threadCount; i++)
+    {
+        queues.push_back(make_unique<WorkerQueue>());
+    }
+    
+    for (int i = 0; i < threadCount; i++)
+    {
+        workers.emplace_back(&ThreadPool::WorkerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        lock_guard<mutex> lock(stateMutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+void ThreadPool::Submit(Task task)
+{
+    // Workers keep their own subtasks local; outside submissions round-robin
+    int index = (currentPool == this) ? currentWorker
+                                      : static_cast<int>(nextQueue++ % queues.size());
+    
+    // Count the task before it becomes visible so Wait() can't see zero early
+    {
+        lock_guard<mutex> lock(stateMutex);
+        queuedTasks++;
+        pendingTasks++;
+    }
+    
+    {
+        lock_guard<mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(move(task));
+    }
+    workAvailable.notify_one();
+}
+
+void ThreadPool::Wait()
+{
+    unique_lock<mutex> lock(stateMutex);
+    allDone.wait(lock, [this] { return pendingTasks == 0; });
+}
+
+void ThreadPool::WorkerLoop(int index)
+{
+    currentWorker = index;
+    currentPool = this;
+    
+    while (true)
+    {
+        Task task;
+        
+        if (TryPopOwn(index, task) || TrySteal(index, task))
+        {
+            {
+                lock_guard<mutex> lock(stateMutex);
+                queuedTasks--;
+            }
+            
+            task();
+            
+            bool finished;
+            {
+                lock_guard<mutex> lock(stateMutex);
+                finished = (--pendingTasks == 0);
+            }
+            if (finished)
+            {
+                allDone.notify_all();
+            }
+            continue;
+        }
+        
+        unique_lock<mutex> lock(stateMutex);
+        workAvailable.wait(lock, [this] { return stopping || queuedTasks > 0; });
+        if (stopping && queuedTasks == 0)
+        {
+            return;
+        }
+    }
+}
+
+bool ThreadPool::TryPopOwn(int index, Task& task)
+{
+    WorkerQueue& queue = *queues[index];
+    lock_guard<mutex> lock(queue.mutex);
+    
+    if (queue.tasks.empty())
+        return false;
+    
+    task = move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::TrySteal(int index, Task& task)
+{
+    int count = static_cast<int>(queues.size());
+    
+    for (int offset = 1; offset < count; offset++)
+    {
+        WorkerQueue& victim = *queues[(index + offset) % count];
+        lock_guard<mutex> lock(victim.mutex);
+        
+        if (!victim.tasks.empty())
+        {
+            task = move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,93 @@
+#include "TranspositionTable.hpp"
+#include <algorithm>
+
+using namespace std;
+
+namespace
+{
+    // Packed layout: score in bits 0-31, depth in 32-39, bound in 40-41,
+    // move in 42-44 (0 = none, else direction + 1), valid flag in bit 63 so
+    // an empty slot never matches
+    constexpr uint64_t VALID_BIT = uint64_t{1} << 63;
+    constexpr int MAX_DEPTH = 255;
+    
+    int MoveCode(Cell move)
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            if (move == DIRECTIONS[i])
+                return i + 1;
+        }
+        return 0;
+    }
+}
+
+TranspositionTable::TranspositionTable(int sizeLog2)
+    : slots(new Slot[size_t{1} << sizeLog2]),
+      mask((size_t{1} << sizeLog2) - 1)
+{
+    Clear();
+}
+
+uint64_t TranspositionTable::Pack(const TranspositionEntry& entry)
+{
+    uint64_t depth = static_cast<uint64_t>(clamp(entry.depth, 0, MAX_DEPTH));
+    
+    return static_cast<uint32_t>(entry.score) |
+           (depth << 32) |
+           (static_cast<uint64_t>(entry.bound & 3) << 40) |
+           (static_cast<uint64_t>(MoveCode(entry.bestMove)) << 42) |
+           VALID_BIT;
+}
+
+TranspositionEntry TranspositionTable::Unpack(uint64_t data)
+{
+    int move = static_cast<int>((data >> 42) & 7);
+    
+    return TranspositionEntry{
+        static_cast<int32_t>(static_cast<uint32_t>(data)),
+        static_cast<int>((data >> 32) & 0xff),
+        static_cast<int>((data >> 40) & 3),
+        move == 0 ? Cell{0, 0} : DIRECTIONS[move - 1]
+    };
+}
+
+bool TranspositionTable::Probe(uint64_t key, TranspositionEntry& entry) const
+{
+    const Slot& slot = slots[key & mask];
+    uint64_t data = slot.data.load(memory_order_relaxed);
+    uint64_t check = slot.check.load(memory_order_relaxed);
+    
+    if ((data & VALID_BIT) == 0 || (check ^ data) != key)
+        return false;
+    
+    entry = Unpack(data);
+    return true;
+}
+
+void TranspositionTable::Store(uint64_t key, const TranspositionEntry& entry)
+{
+    Slot& slot = slots[key & mask];
+    
+    // Keep a deeper result for the same position; anything else is replaced
+    uint64_t oldData = slot.data.load(memory_order_relaxed);
+    uint64_t oldCheck = slot.check.load(memory_order_relaxed);
+    if ((oldData & VALID_BIT) != 0 && (oldCheck ^ oldData) == key &&
+        static_cast<int>((oldData >> 32) & 0xff) > entry.depth)
+    {
+        return;
+    }
+    
+    uint64_t data = Pack(entry);
+    slot.check.store(key ^ data, memory_order_relaxed);
+    slot.data.store(data, memory_order_relaxed);
+}
+
+void TranspositionTable::Clear()
+{
+    for (size_t i = 0; i <= mask; i++)
+    {
+        slots[i].check.store(0, memory_order_relaxed);
+        slots[i].data.store(0, memory_order_relaxed);
+    }
+}
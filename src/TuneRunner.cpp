@@ -0,0 +1,252 @@
+#include "AIWeights.hpp"
+#include "GameState.hpp"
+#include "Random.hpp"
+#include "ThreadPool.hpp"
+#include "WeightedAI.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <vector>
+
+using namespace std;
+
+// snake-tune: tunes the WeightedAI weights by self-play on every core and
+// writes them where the game loads them at startup.
+//
+// Usage: snake-tune [generations] [games] [threads] [seed] [weights-file] [checkpoint]
+//
+// Each generation samples candidate weight sets around the current mean
+// (a separable evolution strategy: one step size per weight, adapted from
+// the best candidates), scores each by games matches against the greedy
+// Snake::GetAIDirection bot, and moves the mean towards the winners. All
+// candidates of a generation play the same seeds, so they are compared on
+// equal terms. After every generation the mean is written to the weights
+// file and the search state to the checkpoint; a rerun resumes from it.
+
+namespace
+{
+    constexpr int DEFAULT_GENERATIONS = 30;
+    constexpr long DEFAULT_GAMES = 2000;
+    constexpr uint64_t DEFAULT_SEED = 1;
+    constexpr const char* DEFAULT_CHECKPOINT = "snake-tune.checkpoint";
+    
+    constexpr int POPULATION = 16; // Candidates per generation
+    constexpr int PARENTS = 4;     // Best candidates the next mean is made of
+    constexpr double STEP_LEARNING_RATE = 0.3; // Share of the step size taken from the parents' spread
+    constexpr float MIN_STEP = 0.01f;
+    constexpr float INITIAL_STEP_SHARE = 0.5f; // Of each default weight
+    constexpr int MAX_TICKS_PER_MATCH = 5000;
+    constexpr long GAMES_PER_TASK = 100;
+    
+    struct TuneState
+    {
+        int generation = 0;
+        AIWeights mean = AIWeights::Defaults();
+        AIWeights step = AIWeights::Defaults();
+        double meanScore = 0.0; // Of the parents in the last generation
+    };
+    
+    // Score of weights against the greedy bot on games seed .. seed + count,
+    // switching sides every game: 1 per win, 0.5 per tie or timeout
+    double PlayGames(const AIWeights& weights, uint64_t seed, long count)
+    {
+        WeightedAI ai(weights);
+        double points = 0.0;
+        
+        for (long i = 0; i < count; i++)
+        {
+            GameState game(seed + i);
+            game.player1.direction = {1, 0};
+            game.player2.direction = {-1, 0};
+            int tuned = (i % 2 == 0) ? 1 : 2;
+            Snake& tunedSnake = tuned == 1 ? game.player1 : game.player2;
+            Snake& greedySnake = tuned == 1 ? game.player2 : game.player1;
+            
+            int winner = 3;
+            for (int tick = 0; tick < MAX_TICKS_PER_MATCH; tick++)
+            {
+                Cell tunedMove = ai.BestMove(game, tuned);
+                Cell greedyMove = greedySnake.GetAIDirection(game.food.position, tunedSnake);
+                tunedSnake.Steer(tunedMove);
+                greedySnake.Steer(greedyMove);
+                
+                if (game.Step().gameOver)
+                {
+                    winner = game.winner;
+                    break;
+                }
+            }
+            
+            points += (winner == tuned) ? 1.0 : (winner == 3) ? 0.5 : 0.0;
+        }
+        
+        return points;
+    }
+    
+    // Standard normal sample (Box-Muller)
+    double Gaussian(Random& rng)
+    {
+        double u1 = (rng.Next() + 1.0) / 4294967297.0;
+        double u2 = rng.Next() / 4294967296.0;
+        return sqrt(-2.0 * log(u1)) * cos(6.283185307179586 * u2);
+    }
+    
+    bool LoadCheckpoint(const char* path, TuneState& state)
+    {
+        FILE* file = fopen(path, "r");
+        if (file == nullptr)
+            return false;
+        
+        TuneState loaded;
+        bool valid = fscanf(file, "generation %d\nscore %lf\n", &loaded.generation, &loaded.meanScore) == 2;
+        for (int i = 0; i < AIWeights::count && valid; i++)
+        {
+            char name[32];
+            valid = fscanf(file, "%31s %f %f\n", name, &loaded.mean[i], &loaded.step[i]) == 3;
+        }
+        
+        fclose(file);
+        if (valid)
+        {
+            state = loaded;
+        }
+        return valid;
+    }
+    
+    bool SaveCheckpoint(const char* path, const TuneState& state)
+    {
+        FILE* file = fopen(path, "w");
+        if (file == nullptr)
+            return false;
+        
+        fprintf(file, "generation %d\nscore %.6f\n", state.generation, state.meanScore);
+        for (int i = 0; i < AIWeights::count; i++)
+        {
+            fprintf(file, "%s %.6g %.6g\n", AIWeights::Name(i), state.mean[i], state.step[i]);
+        }
+        
+        return fclose(file) == 0;
+    }
+    
+    void PrintWeights(const char* label, const AIWeights& weights)
+    {
+        printf("%s", label);
+        for (int i = 0; i < AIWeights::count; i++)
+        {
+            printf(" %s=%.3f", AIWeights::Name(i), weights[i]);
+        }
+        printf("\n");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int generations = argc > 1 ? atoi(argv[1]) : DEFAULT_GENERATIONS;
+    long games = argc > 2 ? atol(argv[2]) : DEFAULT_GAMES;
+    int threads = argc > 3 ? atoi(argv[3]) : 0;
+    uint64_t seed = argc > 4 ? strtoull(argv[4], nullptr, 10) : DEFAULT_SEED;
+    const char* weightsPath = argc > 5 ? argv[5] : AIWeights::defaultPath;
+    const char* checkpointPath = argc > 6 ? argv[6] : DEFAULT_CHECKPOINT;
+    
+    TuneState state;
+    for (int i = 0; i < AIWeights::count; i++)
+    {
+        state.step[i] = max(MIN_STEP, fabs(state.mean[i]) * INITIAL_STEP_SHARE);
+    }
+    
+    if (LoadCheckpoint(checkpointPath, state))
+    {
+        printf("resuming from %s at generation %d\n", checkpointPath, state.generation);
+    }
+    PrintWeights("start:", state.mean);
+    
+    ThreadPool pool(threads);
+    
+    for (; state.generation < generations; state.generation++)
+    {
+        auto start = chrono::steady_clock::now();
+        
+        // Same candidates and seeds for a generation whenever it is rerun
+        Random rng(seed * 1000003 + state.generation);
+        uint64_t gameSeed = seed + static_cast<uint64_t>(state.generation) * games;
+        
+        AIWeights candidates[POPULATION];
+        for (AIWeights& candidate : candidates)
+        {
+            for (int i = 0; i < AIWeights::count; i++)
+            {
+                candidate[i] = state.mean[i] + state.step[i] * static_cast<float>(Gaussian(rng));
+            }
+        }
+        
+        double points[POPULATION] = {};
+        mutex pointsMutex;
+        
+        for (int c = 0; c < POPULATION; c++)
+        {
+            for (long first = 0; first < games; first += GAMES_PER_TASK)
+            {
+                long count = min(GAMES_PER_TASK, games - first);
+                
+                pool.Submit([=, &candidates, &points, &pointsMutex] {
+                    double local = PlayGames(candidates[c], gameSeed + first, count);
+                    
+                    lock_guard<mutex> lock(pointsMutex);
+                    points[c] += local;
+                });
+            }
+        }
+        pool.Wait();
+        
+        // Best first
+        int order[POPULATION];
+        for (int c = 0; c < POPULATION; c++) order[c] = c;
+        sort(order, order + POPULATION, [&](int a, int b) { return points[a] > points[b]; });
+        
+        // New mean: the parents' average. New step: moved towards their
+        // spread around the old mean, so it shrinks as they agree.
+        AIWeights mean = state.mean;
+        for (int i = 0; i < AIWeights::count; i++)
+        {
+            double sum = 0.0;
+            double spread = 0.0;
+            for (int p = 0; p < PARENTS; p++)
+            {
+                float value = candidates[order[p]][i];
+                sum += value;
+                spread += (value - state.mean[i]) * (value - state.mean[i]);
+            }
+            
+            mean[i] = static_cast<float>(sum / PARENTS);
+            double step = (1.0 - STEP_LEARNING_RATE) * state.step[i] + STEP_LEARNING_RATE * sqrt(spread / PARENTS);
+            state.step[i] = max(MIN_STEP, static_cast<float>(step));
+        }
+        state.mean = mean;
+        
+        double parentPoints = 0.0;
+        for (int p = 0; p < PARENTS; p++) parentPoints += points[order[p]];
+        state.meanScore = games > 0 ? parentPoints / (PARENTS * games) : 0.0;
+        
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        printf("generation %d: best %.3f, parents %.3f, %.0f games/sec\n", state.generation + 1,
+               games > 0 ? points[order[0]] / games : 0.0, state.meanScore, POPULATION * games / seconds);
+        PrintWeights("  mean:", state.mean);
+        
+        // Progress survives an interrupted run
+        TuneState next = state;
+        next.generation++;
+        if (!state.mean.Save(weightsPath) || !SaveCheckpoint(checkpointPath, next))
+        {
+            fprintf(stderr, "snake-tune: can't write %s or %s\n", weightsPath, checkpointPath);
+            return 1;
+        }
+    }
+    
+    PrintWeights("final:", state.mean);
+    printf("weights written to %s\n", weightsPath);
+    return 0;
+}
@@ -0,0 +1,50 @@
+#include "WeightedAI.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+using namespace std;
+
+namespace
+{
+    int Distance(Cell a, Cell b)
+    {
+        return abs(a.x - b.x) + abs(a.y - b.y);
+    }
+}
+
+Cell WeightedAI::BestMove(const GameState& state, int player)
+{
+    const Snake& snake = player == 1 ? state.player1 : state.player2;
+    const Snake& opponent = player == 1 ? state.player2 : state.player1;
+    
+    floodFill.Load(state);
+    ReachableArea areas[4];
+    floodFill.EvaluateMoves(snake, areas);
+    
+    Cell best = {0, 0};
+    float bestScore = 0.0f;
+    
+    for (int move = 0; move < 4; move++)
+    {
+        // Reversing, walls and bodies all have no room
+        if (areas[move].area == 0)
+            continue;
+        
+        Cell next = snake.body[0] + DIRECTIONS[move];
+        int room = areas[move].area;
+        int closeness = max(0, nearOpponent - Distance(next, opponent.body[0]));
+        
+        float score = -weights.food * Distance(next, state.food.position)
+                    + weights.space * min(room, spaceCap)
+                    - weights.trapped * (room < snake.body.size() ? 1.0f : 0.0f)
+                    - weights.opponent * closeness;
+        
+        if (best == Cell{0, 0} || score > bestScore)
+        {
+            best = DIRECTIONS[move];
+            bestScore = score;
+        }
+    }
+    
+    return best;
+}
@@ -3,7 +3,14 @@
 #include "GameScene.hpp"
 #include "AIGameScene.hpp"
 #include "AIvsAIScene.hpp"
+#include "AIWeights.hpp"
+#include "OpeningBook.hpp"
+#include "PolicyNetwork.hpp"
+#include "ReplayScene.hpp"
 #include "Game.hpp"
+#include "Global.hpp"
+#include "ReplayLog.hpp"
+#include "ReplayWriter.hpp"
 #include "raylib.h"
 #include <memory>
 
@@ -36,6 +43,9 @@ void RegisterScenes()
     
     // Register AIvsAI Game scene (Build Index: 3)
     sceneManager.RegisterScene(std::make_unique<AIvsAIScene>());
+    
+    // Register Replay viewer scene (Build Index: 4)
+    sceneManager.RegisterScene(std::make_unique<ReplayScene>());
 }
 
 int main() 
@@ -44,6 +54,18 @@ int main()
 
     SetExitKey(0);
     
+    // Every played round is appended to the replay log
+    Global::replayWriter = std::make_unique<ReplayWriter>(ReplayLog::defaultPath);
+    
+    // Weights from snake-tune for the TUNED AI; the defaults if there are none
+    AIWeights::active.Load(AIWeights::defaultPath);
+    
+    // Trained network for the NEURAL AI, if there is one
+    PolicyNetwork::active.Load(PolicyNetwork::defaultPath);
+    
+    // Opening book from snake-book for the searching AIs; only mapped, not read
+    OpeningBook::active = std::make_unique<OpeningBook>(OpeningBook::defaultPath);
+    
     // Register all scenes with the SceneManager
     RegisterScenes();
     
@@ -57,6 +79,14 @@ int main()
         SceneManager::GetInstance().Draw();
     }
     
+    // Unload the active scene so an unfinished round is still recorded,
+    // then flush pending replays
+    if (SceneManager::GetInstance().GetActiveScene() != nullptr)
+    {
+        SceneManager::GetInstance().GetActiveScene()->OnUnload();
+    }
+    Global::replayWriter.reset();
+    
     // Clean up audio device before closing
     if (IsAudioDeviceReady())
     {
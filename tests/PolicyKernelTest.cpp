@@ -0,0 +1,80 @@
+#include "GameState.hpp"
+#include "Observation.hpp"
+#include "PolicyNetwork.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// Regression test: the AVX2 and scalar PolicyNetwork kernels must give
+// bit-identical logits, so the NEURAL AI picks the same moves on every CPU.
+// Evaluates a random 2500-64-32-4 network on positions from greedy games with
+// each kernel set and compares the results bit for bit.
+
+namespace
+{
+    constexpr int POSITIONS = 256; // Observations are two per position
+    constexpr int HIDDEN_WIDTH = 64;
+    constexpr uint64_t SEED = 1;
+}
+
+int main()
+{
+    if (!PolicyNetwork::UseKernels("avx2"))
+    {
+        printf("SKIP: this CPU has no AVX2/FMA kernels to compare\n");
+        return 0;
+    }
+    
+    PolicyNetwork network;
+    network.Randomize({HIDDEN_WIDTH, HIDDEN_WIDTH / 2}, SEED);
+    
+    std::vector<uint64_t> observations(size_t(POSITIONS) * 2 * Observation::wordCount);
+    GameState game(SEED);
+    game.player1.direction = {1, 0};
+    game.player2.direction = {-1, 0};
+    
+    for (int i = 0; i < POSITIONS; i++)
+    {
+        Observation::Write(game, 1, &observations[size_t(2 * i) * Observation::wordCount]);
+        Observation::Write(game, 2, &observations[size_t(2 * i + 1) * Observation::wordCount]);
+        
+        game.player1.Steer(game.player1.GetAIDirection(game.food.position, game.player2));
+        game.player2.Steer(game.player2.GetAIDirection(game.food.position, game.player1));
+        if (game.Step().gameOver)
+        {
+            game.running = true;
+        }
+    }
+    
+    int count = 2 * POSITIONS * PolicyNetwork::outputCount;
+    std::vector<float> avx2(count);
+    std::vector<float> scalar(count);
+    PolicyNetwork::Scratch scratch;
+    
+    network.Evaluate(observations.data(), 2 * POSITIONS, avx2.data(), scratch);
+    PolicyNetwork::UseKernels("scalar");
+    network.Evaluate(observations.data(), 2 * POSITIONS, scalar.data(), scratch);
+    
+    int mismatches = 0;
+    for (int i = 0; i < count; i++)
+    {
+        if (memcmp(&avx2[i], &scalar[i], sizeof(float)) != 0)
+        {
+            if (mismatches == 0)
+            {
+                printf("logit %d: avx2 %.9g, scalar %.9g\n", i, avx2[i], scalar[i]);
+            }
+            mismatches++;
+        }
+    }
+    
+    if (mismatches > 0)
+    {
+        printf("FAIL: %d of %d logits differ between the avx2 and scalar kernels\n", mismatches, count);
+        return 1;
+    }
+    
+    printf("PASS: %d logits bit-identical between the avx2 and scalar kernels\n", count);
+    return 0;
+}
@@ -0,0 +1,76 @@
+#include "GameState.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+// Regression test: GameState::Step must not touch the heap. Replaces the
+// global operator new to count allocations, plays greedy AI vs greedy AI
+// through many rounds and fails if any tick after warm-up allocated.
+
+namespace
+{
+    constexpr int WARMUP_TICKS = 1000;
+    constexpr int MEASURED_TICKS = 200000;
+    
+    long allocations = 0;
+}
+
+void* operator new(std::size_t size)
+{
+    allocations++;
+    if (void* memory = std::malloc(size == 0 ? 1 : size))
+        return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+int main()
+{
+    GameState game(1);
+    game.player1.direction = {1, 0};
+    game.player2.direction = {-1, 0};
+    
+    long rounds = 0;
+    long measuredAllocations = 0;
+    
+    for (int tick = 0; tick < WARMUP_TICKS + MEASURED_TICKS; tick++)
+    {
+        if (tick == WARMUP_TICKS)
+        {
+            measuredAllocations = allocations;
+        }
+        
+        game.player1.Steer(game.player1.GetAIDirection(game.food.position, game.player2));
+        game.player2.Steer(game.player2.GetAIDirection(game.food.position, game.player1));
+        
+        if (game.Step().gameOver)
+        {
+            // Round over: play on from the start position, as the scenes do
+            game.running = true;
+            game.player1.direction = {1, 0};
+            game.player2.direction = {-1, 0};
+            rounds++;
+        }
+    }
+    
+    measuredAllocations = allocations - measuredAllocations;
+    printf("step allocations: %ld in %d ticks (%ld rounds)\n", measuredAllocations, MEASURED_TICKS, rounds);
+    
+    if (measuredAllocations != 0)
+    {
+        printf("FAIL: GameState::Step allocated\n");
+        return 1;
+    }
+    
+    printf("PASS\n");
+    return 0;
+}